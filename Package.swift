@@ -76,6 +76,13 @@ let package = Package(
             cxxSettings: testCxxSettings + [
                 .define("REALM_DISABLE_METADATA_ENCRYPTION")
             ]),
+        .executableTarget(
+            name: "realm-cpp-sdkBenchmarks",
+            dependencies: ["realm-cpp-sdk", "libcurl"],
+            path: "benchmarks",
+            cxxSettings: testCxxSettings + [
+                .define("REALM_DISABLE_METADATA_ENCRYPTION")
+            ]),
     ],
     cxxLanguageStandard: .cxx20
 )
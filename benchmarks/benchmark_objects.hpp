@@ -0,0 +1,41 @@
+#ifndef REALM_BENCHMARK_OBJECTS_HPP
+#define REALM_BENCHMARK_OBJECTS_HPP
+
+#include <cpprealm/sdk.hpp>
+
+struct Employee: realm::object {
+    realm::persisted<int> _id;
+    realm::persisted<std::string> name;
+    realm::persisted<int> age;
+
+    using schema = realm::schema<"Employee",
+            realm::property<"_id", &Employee::_id, true>,
+            realm::property<"name", &Employee::name>,
+            realm::property<"age", &Employee::age>>;
+};
+
+struct Customer: realm::object {
+    realm::persisted<std::string> email;
+    realm::persisted<std::string> nickname;
+
+    using schema = realm::schema<"Customer",
+            realm::indexed_property<"email", &Customer::email>,
+            realm::property<"nickname", &Customer::nickname>>;
+};
+
+struct Message: realm::object {
+    realm::persisted<std::string> body;
+
+    using schema = realm::schema<"Message", realm::property<"body", &Message::body>>;
+};
+
+struct Roster: realm::object {
+    realm::persisted<std::vector<int>> scores;
+    realm::persisted<std::vector<Employee>> employees;
+
+    using schema = realm::schema<"Roster",
+            realm::property<"scores", &Roster::scores>,
+            realm::property<"employees", &Roster::employees>>;
+};
+
+#endif //REALM_BENCHMARK_OBJECTS_HPP
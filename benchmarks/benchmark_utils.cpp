@@ -0,0 +1,23 @@
+#include "benchmark_utils.hpp"
+
+std::vector<std::pair<std::string /* path */, benchmark_fun_t>>& registered_benchmarks()
+{
+    static std::vector<std::pair<std::string /* path */, benchmark_fun_t>> v;
+    return v;
+}
+
+void register_benchmark(std::pair<std::string /* path */, benchmark_fun_t> f) {
+    registered_benchmarks().push_back(f);
+}
+
+int main() {
+    std::cout<<"Launching "<<registered_benchmarks().size()<<" benchmarks."<<std::endl;
+    for (auto& [path, fn] : registered_benchmarks()) {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + ".lock");
+        std::filesystem::remove(path + ".note");
+        std::cout<<std::filesystem::path(path).stem().string()<<std::endl;
+        fn(path);
+    }
+    return 0;
+}
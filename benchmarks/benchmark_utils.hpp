@@ -0,0 +1,36 @@
+#ifndef REALM_BENCHMARK_UTILS_HPP
+#define REALM_BENCHMARK_UTILS_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#include <cpprealm/sdk.hpp>
+
+namespace bench {
+/// Runs `fn` `iterations` times and reports the mean wall clock time per iteration.
+template <typename Fn>
+void measure(const std::string& label, size_t iterations, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    std::cout<<"  "<<label<<": "<<(elapsed.count() / iterations)<<" ns/iter ("<<iterations<<" iterations)"<<std::endl;
+}
+}
+
+using benchmark_fun_t = void (*)(std::string);
+
+std::vector<std::pair<std::string /* path */, benchmark_fun_t>>& registered_benchmarks();
+
+void register_benchmark(std::pair<std::string /* path */, benchmark_fun_t> f);
+
+#define BENCHMARK(fn) \
+static void fn(std::string path); \
+namespace { struct fn##0 { \
+    fn##0() { register_benchmark({std::string(std::filesystem::current_path() / std::string(#fn)) + ".realm", fn }); } } fn##1; } \
+void fn(std::string path)
+
+#endif //REALM_BENCHMARK_UTILS_HPP
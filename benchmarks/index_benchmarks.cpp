@@ -0,0 +1,24 @@
+#include "benchmark_utils.hpp"
+#include "benchmark_objects.hpp"
+
+using namespace realm;
+
+BENCHMARK(indexed_point_lookup) {
+    constexpr int customer_count = 1'000'000;
+    auto realm = realm::open<Customer>({.path=path});
+    realm.write([&realm] {
+        for (int i = 0; i < customer_count; i++) {
+            auto key = "customer" + std::to_string(i);
+            realm.add(Customer { .email = key, .nickname = key });
+        }
+    });
+
+    bench::measure("indexed equality lookup", 1000, [&](size_t i) {
+        auto key = "customer" + std::to_string((i * 7919) % customer_count);
+        realm.objects<Customer>().where([&key](auto& c) { return c.email == key; }).size();
+    });
+    bench::measure("unindexed equality lookup", 10, [&](size_t i) {
+        auto key = "customer" + std::to_string((i * 7919) % customer_count);
+        realm.objects<Customer>().where([&key](auto& c) { return c.nickname == key; }).size();
+    });
+}
@@ -0,0 +1,68 @@
+#include "benchmark_utils.hpp"
+#include "benchmark_objects.hpp"
+
+#include <ranges>
+
+using namespace realm;
+
+namespace {
+constexpr int list_size = 1'000'000;
+}
+
+BENCHMARK(large_list_append) {
+    auto realm = realm::open<Roster, Employee>({.path=path});
+    auto roster = Roster();
+    realm.write([&realm, &roster] {
+        realm.add(roster);
+    });
+
+    bench::measure("push_back 1M ints", 1, [&](size_t) {
+        realm.write([&] {
+            roster.scores.clear();
+            for (int i = 0; i < list_size; i++) {
+                roster.scores.push_back(i);
+            }
+        });
+    });
+    bench::measure("append_range 1M ints", 1, [&](size_t) {
+        realm.write([&] {
+            roster.scores.assign(std::views::iota(0, list_size));
+        });
+    });
+    bench::measure("resize 1M ints", 1, [&](size_t) {
+        realm.write([&] {
+            roster.scores.resize(0);
+            roster.scores.resize(list_size);
+        });
+    });
+
+    bench::measure("range-for 1M ints", 10, [&](size_t) {
+        int64_t sum = 0;
+        for (auto&& score : roster.scores) {
+            sum += score;
+        }
+        if (sum < 0) {
+            std::cout<<sum<<std::endl;
+        }
+    });
+
+    std::vector<Employee> employees;
+    for (int i = 0; i < list_size; i++) {
+        employees.push_back(Employee { ._id = i, .name = "employee", .age = 0 });
+    }
+    bench::measure("append_range 1M objects", 1, [&](size_t) {
+        realm.write([&] {
+            roster.employees.append_range(employees);
+        });
+    });
+
+    bench::measure("range-for 1M objects", 1, [&](size_t) {
+        int64_t sum = 0;
+        for (auto&& employee : roster.employees) {
+            sum += *employee.age;
+        }
+        if (sum < 0) {
+            std::cout<<sum<<std::endl;
+        }
+    });
+}
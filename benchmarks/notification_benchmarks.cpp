@@ -0,0 +1,54 @@
+#include "benchmark_utils.hpp"
+#include "benchmark_objects.hpp"
+
+using namespace realm;
+
+namespace {
+constexpr int observed_count = 10'000;
+}
+
+BENCHMARK(observe_many_objects) {
+    auto realm = realm::open<Employee>({.path=path});
+    realm.write([&realm] {
+        for (int i = 0; i < observed_count; i++) {
+            realm.add(Employee { ._id = i, .name = "employee", .age = 0 });
+        }
+    });
+
+    std::vector<Employee> employees;
+    for (auto& employee : realm.objects<Employee>()) {
+        employees.push_back(employee);
+    }
+
+    size_t delivered = 0;
+    std::vector<notification_token> tokens;
+    for (auto& employee : employees) {
+        tokens.push_back(employee.observe<Employee>([&delivered](auto&&) {
+            delivered++;
+        }));
+    }
+    bench::measure("observe: commit and deliver", 10, [&](size_t i) {
+        realm.write([&] {
+            for (auto& employee : employees) {
+                employee.age = static_cast<int>(i) + 1;
+            }
+        });
+        realm.write([] { });
+    });
+    tokens.clear();
+
+    for (auto& employee : employees) {
+        tokens.push_back(employee.observe_typed<Employee>([&delivered](auto&) {
+            delivered++;
+        }, false));
+    }
+    bench::measure("observe_typed: commit and deliver", 10, [&](size_t i) {
+        realm.write([&] {
+            for (auto& employee : employees) {
+                employee.age = static_cast<int>(i) + 100;
+            }
+        });
+        realm.write([] { });
+    });
+    std::cout<<"  delivered "<<delivered<<" notifications"<<std::endl;
+}
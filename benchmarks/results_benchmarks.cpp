@@ -0,0 +1,62 @@
+#include "benchmark_utils.hpp"
+#include "benchmark_objects.hpp"
+
+using namespace realm;
+
+namespace {
+constexpr int employee_count = 100'000;
+constexpr size_t page_size = 100;
+
+void populate(auto& realm)
+{
+    realm.write([&realm] {
+        for (int i = 0; i < employee_count; i++) {
+            realm.add(Employee { ._id = i, .name = "employee", .age = i % 100 });
+        }
+    });
+}
+}
+
+BENCHMARK(deep_page_latency) {
+    auto realm = realm::open<Employee>({.path=path});
+    populate(realm);
+
+    for (int depth : {0, employee_count / 2, employee_count - static_cast<int>(page_size)}) {
+        bench::measure("offset page at " + std::to_string(depth), 20, [&](size_t) {
+            auto employees = realm.objects<Employee>();
+            size_t idx = 0;
+            for (auto& employee : employees) {
+                if (idx++ >= depth + page_size) {
+                    break;
+                }
+                *employee.age;
+            }
+        });
+        bench::measure("keyset page at " + std::to_string(depth), 20, [&](size_t) {
+            auto page = realm.objects<Employee>().after(depth - 1).limit(page_size);
+            for (auto& employee : page) {
+                *employee.age;
+            }
+        });
+    }
+}
+
+BENCHMARK(batch_primary_key_lookup) {
+    auto realm = realm::open<Employee>({.path=path});
+    populate(realm);
+
+    std::vector<int> keys;
+    for (int i = 0; i < 5'000; i++) {
+        keys.push_back((i * 7919) % employee_count);
+    }
+    bench::measure("object per key", 20, [&](size_t) {
+        for (auto key : keys) {
+            *realm.object<Employee>(key).age;
+        }
+    });
+    bench::measure("objects_by_primary_key", 20, [&](size_t) {
+        for (auto& employee : realm.objects_by_primary_key<Employee>(keys)) {
+            *employee->age;
+        }
+    });
+}
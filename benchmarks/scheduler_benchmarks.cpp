@@ -0,0 +1,57 @@
+#include "benchmark_utils.hpp"
+#include "benchmark_objects.hpp"
+
+using namespace realm;
+
+#ifdef __linux__
+BENCHMARK(epoll_scheduler) {
+    auto scheduler = std::make_shared<util::EpollScheduler>();
+
+    // Latency: a task invoked from another thread until it runs on the loop.
+    bench::measure("cross-thread invoke latency", 1'000, [&](size_t) {
+        std::atomic<bool> ran = false;
+        auto thread = std::thread([&] {
+            scheduler->invoke([&ran] { ran = true; });
+        });
+        while (!ran) {
+            scheduler->run_once(-1);
+        }
+        thread.join();
+    });
+
+    // Throughput: tasks posted in a burst and drained by the loop.
+    constexpr size_t task_count = 100'000;
+    bench::measure("invoke throughput, 100k tasks", 10, [&](size_t) {
+        size_t ran = 0;
+        for (size_t i = 0; i < task_count; i++) {
+            scheduler->invoke([&ran] { ran++; });
+        }
+        while (ran < task_count) {
+            scheduler->run_once(-1);
+        }
+    });
+
+    // End to end: a commit on another thread until the observer runs on the loop.
+    auto realm = realm::open<Employee>({.path=path, .scheduler=scheduler});
+    realm.write([&realm] {
+        realm.add(Employee { ._id = 0, .name = "employee", .age = 0 });
+    });
+    auto employee = realm.object<Employee>(0);
+    size_t delivered = 0;
+    auto token = employee.observe<Employee>([&delivered](auto&&) {
+        delivered++;
+    });
+    bench::measure("commit to notification latency", 100, [&](size_t i) {
+        auto expected = delivered + 1;
+        auto thread = std::thread([&path, i] {
+            auto realm = realm::open<Employee>({.path=path});
+            auto employee = realm.object<Employee>(0);
+            realm.write([&] { employee.age = static_cast<int>(i); });
+        });
+        thread.join();
+        while (delivered < expected) {
+            scheduler->run_once(-1);
+        }
+    });
+}
+#endif
@@ -21,10 +21,14 @@
 
 #include <filesystem>
 #include <iostream>
+#include <numeric>
+#include <span>
+#include <string_view>
 
 #include <cpprealm/type_info.hpp>
 #include <cpprealm/object.hpp>
 #include <cpprealm/results.hpp>
+#include <cpprealm/scheduler.hpp>
 #include <cpprealm/task.hpp>
 #include <cpprealm/thread_safe_reference.hpp>
 
@@ -69,17 +73,48 @@ struct QtMainLoopScheduler : public QObject, public realm::util::Scheduler {
         m_callback = std::move(fn);
     }
 
+    /// Only one delivery is queued at a time: notifications arriving while one is pending are
+    /// handled by it. Deliveries are spaced at least `min_notify_interval` apart.
     void notify() override
     {
-        schedule(m_callback);
+        if (m_notify_pending.exchange(true)) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this] {
+            auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    m_last_delivery + m_min_notify_interval - std::chrono::steady_clock::now());
+            if (delay.count() > 0) {
+                QTimer::singleShot(delay, this, [this] { deliver(); });
+            } else {
+                deliver();
+            }
+        });
+    }
+
+    /// Sets the minimum time between two notification deliveries, e.g. one frame for UI pacing.
+    void set_min_notify_interval(std::chrono::milliseconds interval)
+    {
+        m_min_notify_interval = interval;
     }
 
     void schedule(std::function<void()> fn) {
         QMetaObject::invokeMethod(this, fn);
     }
 private:
+    void deliver()
+    {
+        m_notify_pending = false;
+        m_last_delivery = std::chrono::steady_clock::now();
+        if (m_callback) {
+            m_callback();
+        }
+    }
+
     std::function<void()> m_callback;
     std::thread::id m_id = std::this_thread::get_id();
+    std::atomic<bool> m_notify_pending = false;
+    std::chrono::milliseconds m_min_notify_interval{0};
+    std::chrono::steady_clock::time_point m_last_delivery;
 };
 static std::shared_ptr<realm::util::Scheduler> make_qt()
 {
@@ -95,6 +130,13 @@ struct db_config {
     std::string path = std::filesystem::current_path().append("default.realm");
 
     std::shared_ptr<SyncConfig> sync_config;
+
+    /// The number of parsed query strings kept by `results<T>::where(const std::string&, std::vector<Mixed>)`.
+    /// A capacity of zero disables the cache.
+    size_t query_cache_capacity = 64;
+    /// The scheduler which delivers notifications for the `db`, e.g. a `util::ExecutorScheduler`.
+    /// If unset, `realm::scheduler` is used.
+    std::shared_ptr<util::Scheduler> scheduler;
 private:
     friend struct User;
     template <type_info::ObjectPersistable ...Ts>
@@ -109,7 +151,9 @@ static std::function<std::shared_ptr<util::Scheduler>()> scheduler = &util::Sche
 
 template <type_info::ObjectPersistable ...Ts>
 struct db {
-    db(db_config config = {}) : config(std::move(config))
+    db(db_config config = {})
+    : config(std::move(config))
+    , m_query_cache(std::make_shared<query_cache>(this->config.query_cache_capacity))
     {
         std::vector<ObjectSchema> schema;
 
@@ -121,14 +165,20 @@ struct db {
             .schema = Schema(schema),
             .schema_version = 0,
             .sync_config = this->config.sync_config,
-            .scheduler = scheduler()
+            .scheduler = this->config.scheduler ? this->config.scheduler : realm::scheduler()
         });
     }
 
     void write(std::function<void()>&& block) const
     {
         m_realm->begin_transaction();
-        block();
+        try {
+            block();
+        } catch (...) {
+            pending_binary_appends::discard(m_realm.get());
+            throw;
+        }
+        pending_binary_appends::flush(m_realm.get());
         m_realm->commit_transaction();
     }
 
@@ -161,7 +211,24 @@ struct db {
     results<T> objects() requires (std::is_same_v<T, Ts> || ...)
     {
         return results<T>(Results(m_realm,
-                                         m_realm->read_group().get_table(ObjectStore::table_name_for_object_type(T::schema::name))));
+                                         m_realm->read_group().get_table(ObjectStore::table_name_for_object_type(T::schema::name))),
+                          m_query_cache);
+    }
+
+    /// Parses `query_string` once against the table for `T`. The returned query can be executed
+    /// repeatedly with different arguments without reparsing.
+    template <type_info::ObjectPersistable T>
+    prepared_query<T> prepare(const std::string& query_string) requires (std::is_same_v<T, Ts> || ...)
+    {
+        return prepared_query<T>(m_realm,
+                                 m_realm->read_group().get_table(ObjectStore::table_name_for_object_type(T::schema::name)),
+                                 query_string);
+    }
+
+    /// Hit and miss counts for the query cache used by `results<T>::where(const std::string&, std::vector<Mixed>)`.
+    const query_cache::statistics& query_cache_stats() const noexcept
+    {
+        return m_query_cache->stats();
     }
 
     template <type_info::ObjectPersistable T>
@@ -171,6 +238,31 @@ struct db {
                                  m_realm);
     }
 
+    /// Looks up the objects with the given primary keys.
+    ///
+    /// The table is resolved once for the whole batch. The returned vector has one entry per key,
+    /// in the order of `primary_keys`, which is empty when there is no object with that key.
+    template <type_info::ObjectPersistable T>
+    std::vector<std::optional<T>> objects_by_primary_key(std::span<const typename T::schema::PrimaryKeyProperty::Result> primary_keys)
+    requires ((std::is_same_v<T, Ts> || ...) && T::schema::HasPrimaryKeyProperty)
+    {
+        using PrimaryKey = typename T::schema::PrimaryKeyProperty::Result;
+        return objects_by_primary_key<T>(primary_keys, [](const PrimaryKey& primary_key) {
+            return Mixed(type_info::convert_if_required<PrimaryKey>(primary_key));
+        });
+    }
+
+    /// Looks up objects with string primary keys without copying the keys into `std::string`s.
+    template <type_info::ObjectPersistable T>
+    std::vector<std::optional<T>> objects_by_primary_key(std::span<const std::string_view> primary_keys)
+    requires ((std::is_same_v<T, Ts> || ...) && T::schema::HasPrimaryKeyProperty
+              && type_info::StringPersistable<typename T::schema::PrimaryKeyProperty::Result>)
+    {
+        return objects_by_primary_key<T>(primary_keys, [](std::string_view primary_key) {
+            return Mixed(StringData(primary_key.data(), primary_key.size()));
+        });
+    }
+
     template <type_info::ObjectPersistable T>
     T* object_new(const typename T::schema::PrimaryKeyProperty::Result& primary_key) requires (std::is_same_v<T, Ts> || ...) {
         auto table = m_realm->read_group().get_table(ObjectStore::table_name_for_object_type(T::schema::name));
@@ -201,6 +293,7 @@ struct db {
 private:
     db(SharedRealm realm)
     : m_realm(realm)
+    , m_query_cache(std::make_shared<query_cache>(config.query_cache_capacity))
     {
         config.path = realm->config().path;
         config.sync_config = realm->config().sync_config;
@@ -210,7 +303,36 @@ private:
     friend task<thread_safe_reference<db<Vs...>>> async_open(db_config config);
     template <typename T>
     friend struct thread_safe_reference;
+
+    template <type_info::ObjectPersistable T, typename PrimaryKey, typename Convert>
+    std::vector<std::optional<T>> objects_by_primary_key(std::span<const PrimaryKey> primary_keys, Convert&& convert)
+    {
+        auto table = m_realm->read_group().get_table(m_realm->schema().find(T::schema::name)->table_key);
+        std::vector<ObjKey> keys;
+        keys.reserve(primary_keys.size());
+        for (auto& primary_key : primary_keys) {
+            keys.push_back(table->find_primary_key(convert(primary_key)));
+        }
+
+        // Materialize the objects in key order, so that consecutive lookups
+        // hit neighbouring clusters instead of jumping around the table.
+        std::vector<size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) {
+            return keys[lhs] < keys[rhs];
+        });
+
+        std::vector<std::optional<T>> objects(keys.size());
+        for (auto idx : order) {
+            if (keys[idx]) {
+                objects[idx] = T::schema::create(table->get_object(keys[idx]), m_realm);
+            }
+        }
+        return objects;
+    }
+
     SharedRealm m_realm;
+    std::shared_ptr<query_cache> m_query_cache;
 };
 
 template <type_info::ObjectPersistable ...Ts>
@@ -237,11 +359,12 @@ static task<thread_safe_reference<db<Ts...>>> async_open(db_config config) {
 	    .schema_mode = SchemaMode::AdditiveExplicit,
         .schema = Schema(schema),
         .schema_version = 0,
-        .sync_config = config.sync_config
+        .sync_config = config.sync_config,
+        .scheduler = config.scheduler
     });
     co_return thread_safe_reference<db<Ts...>>(co_await make_awaitable<ThreadSafeReference>([&async_open_task](auto cb) {
         async_open_task->start(cb);
-    }));
+    }), config.scheduler);
 }
 
 }
@@ -21,9 +21,12 @@
 
 #include <cpprealm/type_info.hpp>
 
+#include <realm/object-store/dictionary.hpp>
 #include <realm/object-store/list.hpp>
 #include <realm/object-store/object.hpp>
 #include <realm/object-store/object_store.hpp>
+#include <realm/object-store/results.hpp>
+#include <realm/object-store/set.hpp>
 #include <realm/object-store/shared_realm.hpp>
 
 #include <any>
@@ -35,6 +38,14 @@ struct NotificationToken;
 struct object;
 template <type_info::ListPersistable T>
 struct persisted_container_base;
+template <type_info::SetPersistable T>
+struct persisted_set_base;
+template <type_info::DictionaryPersistable T>
+struct persisted_dictionary_base;
+template <type_info::Persistable T>
+struct persisted;
+template <typename T>
+struct results;
 /**
  A token which is returned from methods which subscribe to changes to a `realm::object`.
  */
@@ -42,7 +53,16 @@ struct notification_token {
 private:
     template <realm::type_info::ListPersistable T>
     friend struct persisted_container_base;
+    template <realm::type_info::SetPersistable T>
+    friend struct persisted_set_base;
+    template <realm::type_info::DictionaryPersistable T>
+    friend struct persisted_dictionary_base;
+    template <typename T>
+    friend struct results;
     List m_list;
+    object_store::Set m_set;
+    object_store::Dictionary m_dictionary;
+    Results m_results;
     friend struct object;
     realm::Object m_object;
     realm::NotificationToken m_token;
@@ -79,25 +99,73 @@ struct PropertyChange {
     std::optional<std::any> new_value;
 };
 
-template <type_info::ListPersistable T>
+/// An element which moved from index `from` before a change to index `to` after it.
+struct CollectionMove {
+    uint64_t from;
+    uint64_t to;
+};
+
+template <typename T>
+requires (type_info::ListPersistable<T> || type_info::SetPersistable<T>)
 struct CollectionChange {
-    /// The list being observed.
-    const persisted_container_base<T>* collection;
+    /// The list or set being observed. Indices into a set refer to its values in sorted order.
+    const persisted<T>* collection;
     std::vector<uint64_t> deletions;
     std::vector<uint64_t> insertions;
     std::vector<uint64_t> modifications;
+    /// Elements which changed position through `move` or `swap`. The indices of a move are
+    /// also reported in `deletions` and `insertions`, so consumers which ignore moves still
+    /// see a consistent change.
+    std::vector<CollectionMove> moves;
 
     // This flag indicates whether the underlying object which is the source of this
     // collection was deleted. This applies to lists, dictionaries and sets.
     // This enables notifiers to report a change on empty collections that have been deleted.
     bool collection_root_was_deleted = false;
 
+    bool empty() const noexcept {
+        return deletions.empty() && insertions.empty() && modifications.empty() && moves.empty() &&
+        !collection_root_was_deleted;
+    }
+};
+
+template <type_info::DictionaryPersistable T>
+struct DictionaryChange {
+    /// The dictionary being observed.
+    const persisted<T>* collection;
+    /// Keys which were removed.
+    std::vector<std::string> deletions;
+    /// Keys which were added.
+    std::vector<std::string> insertions;
+    /// Keys whose values changed.
+    std::vector<std::string> modifications;
+
+    bool collection_root_was_deleted = false;
+
     bool empty() const noexcept {
         return deletions.empty() && insertions.empty() && modifications.empty() &&
         !collection_root_was_deleted;
     }
 };
 
+template <typename T>
+struct ResultsChange {
+    /// The results being observed.
+    const results<T>* collection;
+    /// Indices of the removed objects, in the results before the change.
+    std::vector<uint64_t> deletions;
+    /// Indices of the inserted objects, in the results after the change.
+    std::vector<uint64_t> insertions;
+    /// Indices of the modified objects, in the results after the change.
+    std::vector<uint64_t> modifications;
+    /// Objects which changed position without being removed, e.g. because a sort key changed.
+    std::vector<CollectionMove> moves;
+
+    bool empty() const noexcept {
+        return deletions.empty() && insertions.empty() && modifications.empty() && moves.empty();
+    }
+};
+
 } // namespace realm
 
 #endif /* notifications_hpp */
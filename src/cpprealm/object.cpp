@@ -23,7 +23,13 @@ namespace realm {
 void object::write(std::function<void()> fn)
 {
     m_realm->begin_transaction();
-    fn();
+    try {
+        fn();
+    } catch (...) {
+        pending_binary_appends::discard(m_realm.get());
+        throw;
+    }
+    pending_binary_appends::flush(m_realm.get());
     m_realm->commit_transaction();
 }
 
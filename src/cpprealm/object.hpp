@@ -29,7 +29,10 @@
 #include <realm/object-store/object_store.hpp>
 #include <realm/object-store/shared_realm.hpp>
 
+#include <algorithm>
 #include <any>
+#include <array>
+#include <variant>
 
 namespace realm {
 
@@ -62,11 +65,66 @@ struct ObjectChange {
      One or more of the properties of the object have been changed.
      */
     PropertyChange property;
+    /**
+     All of the properties changed by a commit, when observing with `observe_coalesced`.
+     */
+    std::vector<PropertyChange> properties;
+};
+
+namespace {
+template <typename Properties>
+struct property_variant;
+template <typename ...Properties>
+struct property_variant<std::tuple<Properties...>> {
+    using type = std::variant<typename Properties::Result...>;
+};
+}
+
+// MARK: TypedPropertyChange
+/**
+ A change to one property of a `realm::object`, with the values held as the property's own type
+ rather than as `std::any`.
+ */
+template <type_info::ObjectPersistable T>
+struct TypedPropertyChange {
+    /// Holds one alternative per schema property, in schema order, so that `index()` is the
+    /// index of the property in `T::schema::properties`. Use `std::visit` or `std::get<I>` to read it.
+    using value_type = typename property_variant<std::remove_cv_t<decltype(T::schema::properties)>>::type;
+
+    /// The name of the property which changed.
+    const char* name;
+    /// Value of the property before the change occurred. Only set when old values were requested.
+    std::optional<value_type> old_value;
+    /// The value of the property after the change occurred.
+    value_type new_value;
+};
+
+/**
+ Information about the changes made to an object by one commit, passed to `observe_typed` blocks.
+ */
+template <type_info::ObjectPersistable T>
+struct TypedObjectChange {
+    /// The object being observed.
+    const T* object = nullptr;
+    /// The object has been deleted from the Realm.
+    bool is_deleted = false;
+    /// Set if an error occurred; the block will not be called again.
+    std::exception_ptr error;
+    /// The properties changed by the commit.
+    std::vector<TypedPropertyChange<T>> properties;
 };
 
 namespace {
 template <type_info::ObjectPersistable T>
 struct ObjectChangeCallbackWrapper;
+template <type_info::ObjectPersistable T>
+struct TypedChangeCallbackWrapper;
+template <type_info::ObjectPersistable T>
+using ObjectNotificationCallback = std::function<void(const T*,
+                                                      std::vector<std::string> property_names,
+                                                      std::vector<std::any> old_values,
+                                                      std::vector<std::any> new_values,
+                                                      std::exception_ptr error)>;
 }
 // MARK: Object
 /**
@@ -165,31 +223,86 @@ struct object {
      callback block. There is no retain cycle due to that the callback is
      retained by the returned token and not by the object itself.
 
+     Passing key paths restricts the notifications to changes of those properties.
+     The filter is applied by core, so changes to other properties never call the block:
+     ```cpp
+     dog.observe<Dog>([](auto&& change) {
+        // ...
+     }, &Dog::name, &Dog::adopted);
+     ```
+
      @warning: This method cannot be called during a write transaction, or when
                 the containing Realm is read-only.
      @parameter block: The block to call with information about changes to the object.
+     @parameter key_paths: The properties to observe. All properties are observed if none are given.
      @returns: A token which must be held for as long as you want updates to be delivered.
      */
-    template <typename T>
-    notification_token observe(std::function<void(ObjectChange<T>)> block);
+    template <typename T, typename ...Vs>
+    notification_token observe(std::function<void(ObjectChange<T>)> block, persisted<Vs> T::*... key_paths);
+
+    /**
+     Registers a block to be called once for each commit which changes the object.
+
+     Unlike `observe`, which calls the block once per changed property, the block receives
+     a single `ObjectChange` whose `properties` hold every property changed by the commit.
+     This keeps bulk edits to one callback.
+
+     @parameter block: The block to call with information about changes to the object.
+     @parameter key_paths: The properties to observe. All properties are observed if none are given.
+     @returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    template <typename T, typename ...Vs>
+    notification_token observe_coalesced(std::function<void(ObjectChange<T>)> block, persisted<Vs> T::*... key_paths);
 
     bool is_managed() const noexcept {
         return m_obj.has_value();
     }
 
+    /**
+     Registers a block to be called once for each commit which changes the object, with
+     the changed values delivered as their declared types.
+
+     The payload is reused between notifications, so steady-state delivery of scalar values does
+     not allocate. Old values are only read when `include_old_values` is true, and are only
+     available for commits made on other threads: by the time the commits of this thread are
+     delivered the object already holds the new values, so `old_value` is left empty.
+     ```cpp
+     dog.observe_typed<Dog>([](auto& change) {
+        for (auto& property : change.properties) {
+            std::visit([](auto& value) { ... }, property.new_value);
+        }
+     }, false, &Dog::name);
+     ```
+
+     @parameter block: The block to call with information about changes to the object.
+     @parameter include_old_values: Whether to read the values of changed properties before the commit.
+     @parameter key_paths: The properties to observe. All properties are observed if none are given.
+     @returns: A token which must be held for as long as you want updates to be delivered.
+     */
+    template <typename T, typename ...Vs>
+    notification_token observe_typed(std::function<void(const TypedObjectChange<T>&)> block,
+                                     bool include_old_values, persisted<Vs> T::*... key_paths);
+
 private:
+    template <typename T, typename ...Vs>
+    util::Optional<KeyPathArray> key_path_array(persisted<Vs> T::*... key_paths) const;
+    template <typename T, typename ...Vs>
+    notification_token observe_properties(ObjectNotificationCallback<T> callback, persisted<Vs> T::*... key_paths);
+
     template <type_info::Persistable T>
     friend struct persisted_base;
     template <type_info::OptionalObjectPersistable T>
     friend constexpr typename type_info::persisted_type<T>::type type_info::convert_if_required(const T& a);
     template <type_info::ListPersistable T>
     friend constexpr typename type_info::persisted_type<T>::type type_info::convert_if_required(const T& a);
-    template <StringLiteral, auto Ptr, bool IsPrimaryKey>
+    template <StringLiteral, auto Ptr, bool IsPrimaryKey, bool Indexed>
     friend struct property;
     template <StringLiteral, type_info::Propertyable ...Properties>
     friend struct schema;
     template <type_info::ObjectPersistable T>
     friend struct ObjectChangeCallbackWrapper;
+    template <type_info::ObjectPersistable T>
+    friend struct TypedChangeCallbackWrapper;
     template <type_info::ObjectPersistable ...Ts>
     friend struct db;
     template <typename T>
@@ -219,24 +332,155 @@ inline bool operator==(const T& lhs, const T& rhs) {
 // MARK: - Implementations
 
 namespace {
+/// Maps the columns of `T`'s table to the index of the property stored in them, and reads
+/// properties by index. Built once per subscription, so that processing a notification only
+/// does work proportional to the number of changed columns.
 template <type_info::ObjectPersistable T>
-using ObjectNotificationCallback = std::function<void(const T*,
-                                                      std::vector<std::string> property_names,
-                                                      std::vector<std::any> old_values,
-                                                      std::vector<std::any> new_values,
-                                                      std::exception_ptr error)>;
+struct property_dispatch_table {
+    using value_type = typename TypedPropertyChange<T>::value_type;
+    static constexpr size_t property_count = std::variant_size_v<value_type>;
+    static constexpr size_t npos = size_t(-1);
+
+    static constexpr std::array<const char*, property_count> names = std::apply([](auto&&... props) {
+        return std::array<const char*, property_count> { props.name... };
+    }, T::schema::properties);
+
+    explicit property_dispatch_table(const Table& table) {
+        std::apply([&](auto&&... props) {
+            size_t property_index = 0;
+            ([&] {
+                auto column_key = table.get_column_key(props.name);
+                auto column_index = column_key.get_index().val;
+                if (m_property_indices.size() <= column_index) {
+                    m_property_indices.resize(column_index + 1, npos);
+                }
+                m_property_indices[column_index] = property_index;
+                m_column_keys[property_index++] = column_key;
+            }(), ...);
+        }, T::schema::properties);
+    }
+
+    /// The index in `T::schema::properties` of the property stored in the column with
+    /// the given key value, or `npos` if the column is not a persisted property of `T`.
+    size_t property_index(int64_t column_key_value) const noexcept {
+        auto column_index = ColKey(column_key_value).get_index().val;
+        if (column_index >= m_property_indices.size()) {
+            return npos;
+        }
+        auto property_index = m_property_indices[column_index];
+        // A column index can be shared with a column of a computed property, so the
+        // full key has to match.
+        if (property_index == npos || m_column_keys[property_index].value != column_key_value) {
+            return npos;
+        }
+        return property_index;
+    }
+
+    /// The indices of the properties changed in `c`, in schema order.
+    void changed_properties(realm::CollectionChangeSet const& c, std::vector<size_t>& property_indices) const {
+        property_indices.clear();
+        for (auto& [column_key_value, _] : c.columns) {
+            if (auto property_index = this->property_index(column_key_value); property_index != npos) {
+                property_indices.push_back(property_index);
+            }
+        }
+        std::sort(property_indices.begin(), property_indices.end());
+    }
+
+    static value_type read(const T& object, size_t property_index) {
+        return read(object, property_index, std::make_index_sequence<property_count>());
+    }
+
+    static std::any read_any(const T& object, size_t property_index) {
+        return std::visit([](auto&& value) { return std::any(std::move(value)); }, read(object, property_index));
+    }
+
+private:
+    template <size_t ...Is>
+    static value_type read(const T& object, size_t property_index, std::index_sequence<Is...>) {
+        using reader = value_type (*)(const T&);
+        static constexpr reader readers[] = {
+            +[](const T& object) {
+                constexpr auto ptr = std::tuple_element_t<Is, std::remove_cv_t<decltype(T::schema::properties)>>::ptr;
+                return value_type(std::in_place_index<Is>, *(object.*ptr));
+            }...
+        };
+        return readers[property_index](object);
+    }
+
+    std::vector<size_t> m_property_indices;
+    std::array<ColKey, property_count> m_column_keys;
+};
+}
 
+template <typename T, typename ...Vs>
+notification_token object::observe(std::function<void(ObjectChange<T>)> block, persisted<Vs> T::*... key_paths) {
+    return observe_properties<T>([block](const T* ptr,
+                                         std::vector<std::string> property_names,
+                                         std::vector<std::any> old_values,
+                                         std::vector<std::any> new_values,
+                                         std::exception_ptr error) {
+        if (!ptr) {
+            if (error) {
+                block(ObjectChange<T> { .error = error });
+            } else {
+                block(ObjectChange<T> { .is_deleted = true });
+            }
+        } else {
+            for (size_t i = 0; i < property_names.size(); i++) {
+                PropertyChange property;
+                property.name = property_names[i];
+                if (old_values.size()) {
+                    property.old_value = old_values[i];
+                }
+                if (new_values.size()) {
+                    property.new_value = new_values[i];
+                }
+                block(ObjectChange<T> { .object = ptr, .property = property });
+            }
+        }
+    }, key_paths...);
+}
 
+template <typename T, typename ...Vs>
+notification_token object::observe_coalesced(std::function<void(ObjectChange<T>)> block, persisted<Vs> T::*... key_paths) {
+    return observe_properties<T>([block](const T* ptr,
+                                         std::vector<std::string> property_names,
+                                         std::vector<std::any> old_values,
+                                         std::vector<std::any> new_values,
+                                         std::exception_ptr error) {
+        if (!ptr) {
+            if (error) {
+                block(ObjectChange<T> { .error = error });
+            } else {
+                block(ObjectChange<T> { .is_deleted = true });
+            }
+            return;
+        }
+        std::vector<PropertyChange> properties(property_names.size());
+        for (size_t i = 0; i < property_names.size(); i++) {
+            properties[i].name = std::move(property_names[i]);
+            if (old_values.size()) {
+                properties[i].old_value = std::move(old_values[i]);
+            }
+            if (new_values.size()) {
+                properties[i].new_value = std::move(new_values[i]);
+            }
+        }
+        block(ObjectChange<T> { .object = ptr, .properties = std::move(properties) });
+    }, key_paths...);
 }
 
-template <typename T>
-notification_token object::observe(std::function<void(ObjectChange<T>)> block) {
+template <typename T, typename ...Vs>
+notification_token object::observe_properties(ObjectNotificationCallback<T> callback, persisted<Vs> T::*... key_paths) {
   struct ObjectChangeCallbackWrapper {
     ObjectNotificationCallback<T> block;
     const T& object;
+    property_dispatch_table<T> dispatch;
 
     std::optional<std::vector<std::string>> property_names = std::nullopt;
     std::optional<std::vector<std::any>> old_values = std::nullopt;
+    std::vector<size_t> property_indices;
     bool deleted = false;
 
     void populateProperties(realm::CollectionChangeSet const& c) {
@@ -251,17 +495,12 @@ notification_token object::observe(std::function<void(ObjectChange<T>)> block) {
             return;
         }
 
-        // FIXME: It's possible for the column key of a persisted property
-        // to equal the column key of a computed property.
-        auto properties = std::vector<std::string>();
-        TableRef table = object.m_realm->read_group().get_table(ObjectStore::table_name_for_object_type(T::schema::name));
-
-        std::apply([&c, &table, &properties](auto&&... props) {
-            (((c.columns.count(table->get_column_key(props.name).value)) ?
-              properties.push_back(props.name) : void()), ...);
-        }, T::schema::properties);
-        if (!properties.empty()) {
-            property_names = properties;
+        dispatch.changed_properties(c, property_indices);
+        if (!property_indices.empty()) {
+            property_names.emplace();
+            for (auto property_index : property_indices) {
+                property_names->push_back(dispatch.names[property_index]);
+            }
         }
     }
 
@@ -275,10 +514,9 @@ notification_token object::observe(std::function<void(ObjectChange<T>)> block) {
         }
 
         std::vector<std::any> values;
-        for (auto& name : *property_names) {
-            std::apply([&name, &values, this](auto&&... props) {
-                ((name == props.name ? values.push_back(*(object.*props.ptr)) : void()), ...);
-            }, T::schema::properties);
+        values.reserve(property_indices.size());
+        for (auto property_index : property_indices) {
+            values.push_back(dispatch.read_any(object, property_index));
         }
         return values;
     }
@@ -308,33 +546,125 @@ notification_token object::observe(std::function<void(ObjectChange<T>)> block) {
     notification_token token;
     token.m_object = realm::Object(m_realm, T::schema::to_core_schema(), *(m_obj));
     token.m_token = token.m_object.add_notification_callback(ObjectChangeCallbackWrapper{
-        [block](const T* ptr,
-                std::vector<std::string> property_names,
-                std::vector<std::any> old_values,
-                std::vector<std::any> new_values,
-                std::exception_ptr error) {
-            if (!ptr) {
-                if (error) {
-                    block(ObjectChange<T> { .error = error });
-                } else {
-                    block(ObjectChange<T> { .is_deleted = true });
-                }
-            } else {
-                for (size_t i = 0; i < property_names.size(); i++) {
-                    PropertyChange property;
-                    property.name = property_names[i];
-                    if (old_values.size()) {
-                        property.old_value = old_values[i];
-                    }
-                    if (new_values.size()) {
-                        property.new_value = new_values[i];
+        std::move(callback), *static_cast<T*>(this), property_dispatch_table<T>(*m_obj->get_table())},
+        key_path_array<T>(key_paths...));
+    return token;
+};
+
+template <typename T, typename ...Vs>
+util::Optional<KeyPathArray> object::key_path_array(persisted<Vs> T::*... key_paths) const {
+    util::Optional<KeyPathArray> key_path_array;
+    if constexpr (sizeof...(Vs) > 0) {
+        auto table = m_obj->get_table();
+        auto column_key_for = [&table](auto key_path) {
+            ColKey column_key;
+            std::apply([&](auto&&... props) {
+                ([&] {
+                    if constexpr (std::is_same_v<std::remove_cv_t<decltype(props.ptr)>, decltype(key_path)>) {
+                        if (props.ptr == key_path) {
+                            column_key = table->get_column_key(props.name);
+                        }
                     }
-                    block(ObjectChange<T> { .object = ptr, .property = property });
+                }(), ...);
+            }, T::schema::properties);
+            if (!column_key) {
+                throw std::runtime_error("Only properties in the object's schema can be observed");
+            }
+            return column_key;
+        };
+        key_path_array = KeyPathArray { KeyPath { {table->get_key(), column_key_for(key_paths)} }... };
+    }
+    return key_path_array;
+}
+
+namespace {
+template <type_info::ObjectPersistable T>
+struct TypedChangeCallbackWrapper {
+    std::function<void(const TypedObjectChange<T>&)> block;
+    const T& object;
+    bool include_old_values;
+    property_dispatch_table<T> dispatch;
+    TypedObjectChange<T> change;
+    std::vector<size_t> property_indices;
+    bool has_old_values = false;
+    // The version of the Realm when `before` read the old values.
+    VersionID version_before;
+
+    void before(realm::CollectionChangeSet const& c) {
+        if (include_old_values && c.deletions.empty() && !c.columns.empty()) {
+            read_changes(c, true);
+            has_old_values = true;
+            version_before = object.m_realm->read_transaction_version();
+        }
+    }
+
+    void after(realm::CollectionChangeSet const& c) {
+        if (!c.deletions.empty()) {
+            block(TypedObjectChange<T> { .is_deleted = true });
+            return;
+        }
+        if (c.columns.empty()) {
+            return;
+        }
+        if (has_old_values) {
+            // `before` already collected the changed properties, with their old values
+            // copied into `new_value`, whose index is the property index.
+            // A commit made on this thread is already visible when `before` runs, as the Realm
+            // does not advance between `before` and `after`. What `before` read are then the
+            // new values, so no old values are reported.
+            bool local_commit = object.m_realm->read_transaction_version() == version_before;
+            for (auto& property : change.properties) {
+                property.new_value = dispatch.read(object, property.new_value.index());
+                if (local_commit) {
+                    property.old_value.reset();
                 }
             }
-        }, *static_cast<T*>(this)});
-    return token;
+            has_old_values = false;
+        } else {
+            read_changes(c, false);
+        }
+        if (!change.properties.empty()) {
+            change.object = &object;
+            block(change);
+        }
+    }
+
+    void error(std::exception_ptr err) {
+        block(TypedObjectChange<T> { .error = err });
+    }
+
+private:
+    // Fills `change.properties` with the properties changed in `c`, reading their current values.
+    // The payload's storage is reused between notifications.
+    void read_changes(realm::CollectionChangeSet const& c, bool as_old_values) {
+        dispatch.changed_properties(c, property_indices);
+        change.properties.clear();
+        for (auto property_index : property_indices) {
+            auto value = dispatch.read(object, property_index);
+            auto name = dispatch.names[property_index];
+            if (as_old_values) {
+                change.properties.push_back({.name = name, .old_value = value, .new_value = std::move(value)});
+            } else {
+                change.properties.push_back({.name = name, .new_value = std::move(value)});
+            }
+        }
+    }
 };
+}
+
+template <typename T, typename ...Vs>
+notification_token object::observe_typed(std::function<void(const TypedObjectChange<T>&)> block,
+                                         bool include_old_values, persisted<Vs> T::*... key_paths) {
+    if (!m_realm) {
+        throw std::runtime_error("Only objects which are managed by a Realm support change notifications");
+    }
+    notification_token token;
+    token.m_object = realm::Object(m_realm, T::schema::to_core_schema(), *(m_obj));
+    token.m_token = token.m_object.add_notification_callback(TypedChangeCallbackWrapper<T>{
+        std::move(block), *static_cast<T*>(this), include_old_values, property_dispatch_table<T>(*m_obj->get_table())},
+        key_path_array<T>(key_paths...));
+    return token;
+}
 
 } // namespace realm
 
@@ -23,17 +23,33 @@
 #include <cpprealm/type_info.hpp>
 
 #include <realm/query.hpp>
+#include <realm/query_expression.hpp>
+#include <realm/unicode.hpp>
 
 #include <realm/object-store/list.hpp>
 #include <realm/object-store/shared_realm.hpp>
 
 #include <realm/util/functional.hpp>
 
+#include <algorithm>
+#include <compare>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace realm {
 
 struct FieldValue;
 template <type_info::Persistable T>
 struct persisted;
+template <type_info::ObjectPersistable T>
+struct query;
 struct notification_token;
 
 template <typename T>
@@ -43,6 +59,45 @@ concept Equatable = requires (T a) {
 
 class rbool;
 
+namespace {
+template <typename T>
+struct query_type {
+    using type = typename type_info::persisted_type<T>::type;
+};
+template <type_info::OptionalPersistable T>
+struct query_type<T> {
+    using type = typename type_info::persisted_type<typename T::value_type>::type;
+};
+template <type_info::SetPersistable T>
+struct query_type<T> {
+    using type = Set<typename type_info::persisted_type<typename T::value_type>::type>;
+};
+template <type_info::DictionaryPersistable T>
+struct query_type<T> {
+    using type = Dictionary;
+};
+}
+
+/// The links followed to reach a property in the query builder, e.g. `person.dog->name`.
+///
+/// Core applies a single quantifier to every list along a chain of links, so a path
+/// passes through lists with at most one of `any()`, `all()` or `none()`.
+struct link_path {
+    ConstTableRef origin;
+    std::vector<ColKey> links;
+    /// Set once the path passes through a list.
+    std::optional<ExpressionComparisonType> quantifier;
+
+    LinkChain chain() const
+    {
+        auto chain = quantifier ? LinkChain(origin, *quantifier) : LinkChain(origin);
+        for (auto& link : links) {
+            chain.link(link);
+        }
+        return chain;
+    }
+};
+
 template <realm::type_info::Persistable T>
 struct persisted_base {
     using Result = T;
@@ -74,7 +129,7 @@ protected:
         realm::ColKey managed;
     };
 
-    template <StringLiteral Name, auto Ptr, bool>
+    template <StringLiteral Name, auto Ptr, bool, bool>
     friend struct property;
     template <type_info::ObjectPersistable V>
     friend struct query;
@@ -83,18 +138,52 @@ protected:
     template <type_info::TimestampPersistable X, typename U, typename V>
     friend persisted<X>& operator +=(persisted<X>& a, std::chrono::duration<U, V> b);
     type as_core_type() const;
-    void assign(const Obj& object, const ColKey& col_key);
+    void assign(const Obj& object, const ColKey& col_key, SharedRealm realm = nullptr);
     std::optional<Obj> m_obj;
+    // The Realm of the parent object, handed to the objects created when reading links.
+    SharedRealm m_realm;
 
     // MARK: Queries
     bool should_detect_usage_for_queries = false;
     Query* query;
+    // The links followed to reach this property when it is queried through
+    // a link, e.g. `person.dog->name`. Owned by the query object of the link target.
+    const link_path* link_chain = nullptr;
     bool is_and;
     bool is_or;
 
-    void prepare_for_query(Query& query_builder) {
+    void prepare_for_query(Query& query_builder, const link_path* path = nullptr) {
         should_detect_usage_for_queries = true;
         query = &query_builder;
+        link_chain = path;
+    }
+
+    // The column expression for this property, following `link_chain` if it is set.
+    auto query_column() const {
+        auto chain = link_chain ? link_chain->chain() : LinkChain(query->get_table());
+        return chain.template column<typename query_type<T>::type>(managed);
+    }
+
+    // The path to the link target when following `link_col` from this property's table.
+    link_path follow(ColKey link_col) const {
+        auto path = link_chain ? *link_chain : link_path{query->get_table()};
+        path.links.push_back(link_col);
+        return path;
+    }
+
+    // Conditions made of several comparisons on one property can't generally be built through
+    // a list: each comparison is quantified over the list on its own, so e.g. `between` would
+    // match a list where one element is above the lower bound and another below the upper bound.
+    // A disjunction, such as `in`, is the exception under `any()`: "any element equals a or b"
+    // is the same as "any element equals a, or any element equals b".
+    void check_single_comparison(const char* operation, size_t comparisons, bool is_disjunction = false) const {
+        if (comparisons < 2 || !link_chain || !link_chain->quantifier) {
+            return;
+        }
+        if (is_disjunction && *link_chain->quantifier == ExpressionComparisonType::Any) {
+            return;
+        }
+        throw std::logic_error(std::string(operation) + " cannot be used on a property reached through a list");
     }
 
     template <realm::type_info::Persistable V>
@@ -151,6 +240,10 @@ protected:
 ///  and mutating it on an object which has been added to a Realm will throw an
 ///  exception.
 ///
+///  Int, Bool, String, Date and UUID properties can be indexed by declaring them with
+///  `realm::indexed_property` instead of `realm::property`. Indexed properties make
+///  equality queries on them faster, at the cost of slower writes and a larger file.
+///
 ///  Properties can optionally be given a default value using the standard C++20
 ///  syntax. If no default value is given, a value will be generated on first
 ///  access: `nil` for all Optional types, zero for numeric types, false for
@@ -164,6 +257,33 @@ struct persisted : public persisted_base<T> {
     using persisted_base<T>::persisted_base;
 };
 
+/// Returned by `persisted<std::optional<T>>::operator->` to access the linked object.
+///
+/// In the query builder it holds a query object for the link target, so that
+/// comparisons on its properties are evaluated through the link.
+template <type_info::ObjectPersistable T>
+struct link_proxy {
+    T* operator->() {
+        if (m_query) {
+            return &*m_query;
+        }
+        if (!m_object) {
+            throw std::runtime_error("Cannot access properties through a null link");
+        }
+        return &*m_object;
+    }
+private:
+    template <type_info::NonContainerPersistable>
+    friend struct persisted_noncontainer_base;
+
+    link_proxy(std::optional<T>&& object) : m_object(std::move(object)) {}
+    link_proxy(Query& query_builder, link_path&& path) {
+        m_query.emplace(query_builder, std::move(path));
+    }
+    std::optional<T> m_object;
+    std::optional<realm::query<T>> m_query;
+};
+
 template <type_info::NonContainerPersistable T>
 struct persisted_noncontainer_base : public persisted_base<T> {
     using persisted_base<T>::persisted_base;
@@ -186,6 +306,18 @@ struct persisted_noncontainer_base : public persisted_base<T> {
     rbool operator <=(const persisted<T>& a) requires (type_info::Comparable<T>);
     rbool operator >=(const persisted<T>& a) requires (type_info::Comparable<T>);
     rbool contains(const char* str) requires (std::is_same_v<T, std::string>);
+    /// Matches when the string contains every whitespace separated term in `terms`, ignoring case.
+    /// Case is folded with core's Unicode rules, both in queries and on objects. There is no term
+    /// index: in queries every term is a case-insensitive substring scan of the column.
+    rbool matches(const char* terms) requires (std::is_same_v<T, std::string>);
+    /// Matches when the value is equal to any of `values`. In queries this compiles to a
+    /// single OR group on this column, which core evaluates as one set-membership condition.
+    rbool in(std::span<const T> values) requires (Equatable<T>);
+    /// Matches when the value is in the closed range [`lower`, `upper`].
+    rbool between(const T& lower, const T& upper) requires (type_info::Comparable<T>);
+    /// Accesses the linked object. In queries, properties of the linked object are compared
+    /// through the link, e.g. `person.dog->name == "Fido"`.
+    link_proxy<typename T::value_type> operator->() requires (type_info::OptionalObjectPersistable<T>);
 };
 
 template <type_info::TimestampPersistable T, typename U, typename V>
@@ -207,6 +339,151 @@ struct persisted<T> : public persisted_noncontainer_base<T> {
 
 // MARK: Persisted List
 
+/// A read-only random access view over the values of a list of primitives, returned by
+/// `persisted<std::vector<T>>::view()`.
+///
+/// Values of a managed list are read from the Realm on access, without copying the list.
+/// Strings and binary data are exposed as `StringData` and `BinaryData` pointing into the
+/// Realm file. The view is only valid for the read transaction it was created in.
+/// ```cpp
+/// auto total = std::accumulate(person.scores.view().begin(), person.scores.view().end(), 0);
+/// ```
+template <type_info::PrimitivePersistable T>
+class list_view : public std::ranges::view_interface<list_view<T>> {
+    using core_type = typename type_info::persisted_type<T>::type;
+public:
+    using value_type = std::conditional_t<type_info::StringPersistable<T> || type_info::BinaryPersistable<T>,
+                                          core_type, T>;
+
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename list_view::value_type;
+        using iterator_concept = std::random_access_iterator_tag;
+
+        iterator() = default;
+
+        value_type operator*() const
+        {
+            return m_view->get(m_idx);
+        }
+        value_type operator[](difference_type n) const
+        {
+            return m_view->get(m_idx + n);
+        }
+
+        iterator& operator++()
+        {
+            m_idx++;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            auto it = *this;
+            m_idx++;
+            return it;
+        }
+        iterator& operator--()
+        {
+            m_idx--;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            auto it = *this;
+            m_idx--;
+            return it;
+        }
+
+        iterator& operator+=(difference_type n)
+        {
+            m_idx += n;
+            return *this;
+        }
+        iterator& operator-=(difference_type n)
+        {
+            m_idx -= n;
+            return *this;
+        }
+        friend iterator operator+(iterator it, difference_type n)
+        {
+            return it += n;
+        }
+        friend iterator operator+(difference_type n, iterator it)
+        {
+            return it += n;
+        }
+        friend iterator operator-(iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return m_idx == other.m_idx;
+        }
+        auto operator<=>(const iterator& other) const
+        {
+            return m_idx <=> other.m_idx;
+        }
+    private:
+        friend class list_view;
+
+        iterator(size_t idx, const list_view* view)
+                : m_idx(idx)
+                , m_view(view)
+        {
+        }
+
+        size_t m_idx = 0;
+        const list_view* m_view = nullptr;
+    };
+
+    list_view() = default;
+
+    iterator begin() const
+    {
+        return iterator(0, this);
+    }
+    iterator end() const
+    {
+        return iterator(size(), this);
+    }
+    size_t size() const
+    {
+        return m_list ? m_list->size() : m_values->size();
+    }
+
+    value_type get(size_t idx) const
+    {
+        if (m_list) {
+            if constexpr (std::is_same_v<value_type, core_type>) {
+                return m_list->get(idx);
+            } else {
+                return static_cast<value_type>(m_list->get(idx));
+            }
+        }
+        if constexpr (std::is_same_v<value_type, core_type>) {
+            return type_info::convert_if_required<T>((*m_values)[idx]);
+        } else {
+            return (*m_values)[idx];
+        }
+    }
+private:
+    template <type_info::ListPersistable>
+    friend class persisted_container_base;
+
+    list_view(const Lst<core_type>& list) : m_list(&list) {}
+    list_view(const std::vector<T>& values) : m_values(&values) {}
+
+    const Lst<core_type>* m_list = nullptr;
+    const std::vector<T>* m_values = nullptr;
+};
+
 template <realm::type_info::ListPersistable T>
 class persisted_container_base : public persisted_base<T> {
 
@@ -214,34 +491,48 @@ public:
     using value_type = typename T::value_type;
     using size_type = typename T::size_type;
 
+    /// A random access iterator over the list.
+    ///
+    /// Dereferencing the iterator returns the element by value: elements of a managed list are
+    /// read through the list's cached core accessor, and an object element is a new accessor
+    /// for the linked object. Moving and comparing iterators does not read the list, so only
+    /// the elements which are dereferenced are read. Use `view()` to read strings and binary
+    /// data of a managed list without copying them.
     class iterator {
     public:
-        using difference_type = size_type;
-        using value_type = value_type;
-        using pointer = value_type*;
-        using reference = value_type&;
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename T::value_type;
+        using reference = value_type;
+        using iterator_concept = std::random_access_iterator_tag;
+        // Elements are not returned by reference, so to the standard library's classic
+        // algorithms this is only an input iterator.
         using iterator_category = std::input_iterator_tag;
 
-        bool operator!=(const iterator& other) const
-        {
-            return !(*this == other);
-        }
+        // Holds the element read by `operator->` for the duration of the member access.
+        struct arrow_proxy {
+            value_type value;
+            value_type* operator->()
+            {
+                return &value;
+            }
+        };
+        using pointer = arrow_proxy;
 
-        bool operator==(const iterator& other) const
+        iterator() = default;
+
+        reference operator*() const
         {
-            return (m_parent == other.m_parent) && (m_idx == other.m_idx);
+            return (*m_parent)[m_idx];
         }
 
-        reference operator*() noexcept
+        pointer operator->() const
         {
-            value = (*m_parent)[m_idx];
-            return value;
+            return arrow_proxy{**this};
         }
 
-        pointer operator->() const noexcept
+        reference operator[](difference_type n) const
         {
-            value = (*m_parent)[m_idx];
-            return &value;
+            return *(*this + n);
         }
 
         iterator& operator++()
@@ -249,12 +540,62 @@ public:
             m_idx++;
             return *this;
         }
+        iterator operator++(int)
+        {
+            auto it = *this;
+            m_idx++;
+            return it;
+        }
+        iterator& operator--()
+        {
+            m_idx--;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            auto it = *this;
+            m_idx--;
+            return it;
+        }
 
-        iterator& operator++(int i)
+        iterator& operator+=(difference_type n)
+        {
+            m_idx += n;
+            return *this;
+        }
+        iterator& operator-=(difference_type n)
         {
-            m_idx += i;
+            m_idx -= n;
             return *this;
         }
+        friend iterator operator+(iterator it, difference_type n)
+        {
+            return it += n;
+        }
+        friend iterator operator+(difference_type n, iterator it)
+        {
+            return it += n;
+        }
+        friend iterator operator-(iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterator& a, const iterator& b)
+        {
+            return static_cast<difference_type>(a.m_idx) - static_cast<difference_type>(b.m_idx);
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return (m_parent == other.m_parent) && (m_idx == other.m_idx);
+        }
+        std::strong_ordering operator<=>(const iterator& other) const
+        {
+            if (auto order = std::compare_three_way()(m_parent, other.m_parent); order != 0) {
+                return order;
+            }
+            return m_idx <=> other.m_idx;
+        }
     private:
         friend struct persisted_container_base<T>;
 
@@ -264,9 +605,8 @@ public:
         {
         }
 
-        size_t m_idx;
-        persisted_container_base<T>* m_parent;
-        value_type value;
+        size_t m_idx = 0;
+        persisted_container_base<T>* m_parent = nullptr;
     };
 
     iterator begin()
@@ -282,7 +622,7 @@ public:
     size_t size()
     {
         if (this->m_obj) {
-            auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+            auto& lst = this->list();
             return lst.size();
         } else {
             return this->unmanaged.size();
@@ -306,9 +646,49 @@ public:
     size_t find(const value_type& a) requires (type_info::PrimitivePersistable<value_type>);
     size_t find(const value_type& a) requires (type_info::ObjectPersistable<value_type>);
 
+    /// Moves the element at `from` to `to`, shifting the elements in between. Observers are
+    /// notified of a move rather than a deletion and an insertion.
+    void move(size_type from, size_type to);
+    /// Exchanges the elements at `i` and `j`.
+    void swap(size_type i, size_type j);
+
+    /// A read-only view over the values of this list which reads them in place, without
+    /// copying the list. The view of a managed list is valid for the current read transaction.
+    list_view<value_type> view() const requires (type_info::PrimitivePersistable<value_type>)
+    {
+        if (this->m_obj) {
+            return list_view<value_type>(list());
+        }
+        return list_view<value_type>(this->unmanaged);
+    }
+
+    /// Appends the elements of `values`. On a managed list all elements are inserted through
+    /// one accessor, and any unmanaged objects are added to the Realm in a single batch.
+    template <std::ranges::input_range R>
+    void append_range(R&& values);
+    /// Inserts the elements of `values` before `pos`.
+    template <std::ranges::input_range R>
+    void insert(size_type pos, R&& values);
+    /// Replaces the contents of the list with the elements of `values`, which may be a view of this list.
+    template <std::ranges::input_range R>
+    void assign(R&& values);
+    /// Resizes the list to `count` elements, appending default constructed values if it grows.
+    /// A managed list of objects with a primary key can only shrink, since the appended objects
+    /// would all share the default primary key.
+    void resize(size_type count);
+
     notification_token observe(util::UniqueFunction<void(CollectionChange<T>,
                                                          std::exception_ptr)>);
 
+    /// In queries, compares properties of the linked objects in this list. A comparison matches
+    /// when it holds for any, all or none of the linked objects respectively:
+    /// ```cpp
+    /// realm.objects<Person>().where([](auto& person) { return person.dogs.any().age > 10; });
+    /// ```
+    realm::query<value_type> any() requires (type_info::ObjectPersistable<value_type>);
+    realm::query<value_type> all() requires (type_info::ObjectPersistable<value_type>);
+    realm::query<value_type> none() requires (type_info::ObjectPersistable<value_type>);
+
     /// Make this container property managed
     /// @param object The parent object
     /// @param col_key The column key for this property
@@ -316,13 +696,41 @@ public:
     void assign(const Obj& object, const ColKey& col_key, SharedRealm realm);
 
 private:
-    SharedRealm m_realm;
+    realm::query<value_type> quantified(ExpressionComparisonType type);
+
+    using list_type = std::conditional_t<type_info::ObjectPersistable<value_type>,
+                                         LnkLst,
+                                         Lst<typename type_info::persisted_type<value_type>::type>>;
+
+    // The core accessor for the managed list, created on first use. Core accessors
+    // re-sync with their object whenever the content version changes, so the cached
+    // accessor stays valid across transactions and only has to be dropped on `assign`.
+    list_type& list() const
+    {
+        if (!m_list) {
+            if constexpr (type_info::ObjectPersistable<value_type>) {
+                m_list.emplace(this->m_obj->get_linklist(this->managed));
+            } else {
+                m_list.emplace(this->m_obj->template get_list<typename type_info::persisted_type<value_type>::type>(this->managed));
+            }
+        }
+        return *m_list;
+    }
+
+    // Inserts `values` before `pos` in the managed list.
+    template <typename R>
+    void insert_managed(size_type pos, R&& values);
+    // The keys of the objects in `values`, adding any unmanaged ones to the Realm in one batch.
+    template <typename R>
+    std::vector<ObjKey> object_keys(R&& values) requires (type_info::ObjectPersistable<value_type>);
+
+    mutable std::optional<list_type> m_list;
 };
 
 template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::push_back(const typename T::value_type& a) requires (type_info::PrimitivePersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         lst.add(type_info::convert_if_required<typename T::value_type>(a));
     } else {
         this->unmanaged.push_back(a);
@@ -333,9 +741,9 @@ template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::push_back(typename T::value_type& a)
 requires (type_info::ObjectPersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         if (!a.m_obj) {
-            T::value_type::schema::add(a, this->m_obj->get_table()->get_link_target(this->managed), nullptr);
+            T::value_type::schema::add(a, this->m_obj->get_table()->get_link_target(this->managed), this->m_realm);
         }
         lst.add(a.m_obj->get_key());
     } else {
@@ -358,7 +766,7 @@ void persisted_container_base<T>::set(size_type pos, const typename T::value_typ
 requires (type_info::PrimitivePersistable<typename T::value_type>) {
     if (this->m_obj) {
         auto as_core_type = static_cast<typename type_info::persisted_type<typename T::value_type>::type>(a);
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         lst.set(pos, as_core_type);
     } else {
         this->unmanaged[pos] = a;
@@ -369,9 +777,9 @@ template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::set(size_type pos, typename T::value_type& a)
 requires (type_info::ObjectPersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         if (!a.m_obj) {
-            T::value_type::schema::add(a, this->m_obj->get_table()->get_link_target(this->managed), nullptr);
+            T::value_type::schema::add(a, this->m_obj->get_table()->get_link_target(this->managed), this->m_realm);
         }
         lst.set(pos, a.m_obj->get_key());
     } else {
@@ -392,10 +800,7 @@ requires (type_info::ObjectPersistable<typename T::value_type>) {
 template <realm::type_info::ListPersistable T>
 size_t persisted_container_base<T>::find(const typename T::value_type& a) requires (type_info::PrimitivePersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
-        if (auto size = lst.size()) {
-            return lst.find_first(type_info::convert_if_required<typename T::value_type>(a));
-        }
+        return this->list().find_first(type_info::convert_if_required<typename T::value_type>(a));
     } else {
         auto it = std::find(this->unmanaged.begin(), this->unmanaged.end(), a);
         if (it != this->unmanaged.end()) {
@@ -413,10 +818,7 @@ requires (type_info::ObjectPersistable<typename T::value_type>) {
         if (!a.m_obj.has_value()) {
             return realm::npos;
         }
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
-        if (auto size = lst.size()) {
-            return lst.find_first((*a.m_obj).get_key());
-        }
+        return this->list().find_first((*a.m_obj).get_key());
     } else {
         // unmanaged objects in vectors aren't equatable.
         return realm::npos;
@@ -426,7 +828,7 @@ requires (type_info::ObjectPersistable<typename T::value_type>) {
 template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::pop_back() {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         if (auto size = lst.size()) {
             lst.remove(size - 1);
         }
@@ -438,30 +840,170 @@ void persisted_container_base<T>::pop_back() {
 template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::erase(size_type pos) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         lst.remove(pos);
     } else {
         this->unmanaged.erase(this->unmanaged.begin() + pos);
     }
 }
 
+template <realm::type_info::ListPersistable T>
+void persisted_container_base<T>::move(size_type from, size_type to) {
+    if (this->m_obj) {
+        this->list().move(from, to);
+    } else if (from < to) {
+        std::rotate(this->unmanaged.begin() + from, this->unmanaged.begin() + from + 1, this->unmanaged.begin() + to + 1);
+    } else if (from > to) {
+        std::rotate(this->unmanaged.begin() + to, this->unmanaged.begin() + from, this->unmanaged.begin() + from + 1);
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+void persisted_container_base<T>::swap(size_type i, size_type j) {
+    if (this->m_obj) {
+        this->list().swap(i, j);
+    } else {
+        std::swap(this->unmanaged[i], this->unmanaged[j]);
+    }
+}
+
 template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::clear() {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         lst.clear();
     } else {
         this->unmanaged.clear();
     }
 }
 
+template <realm::type_info::ListPersistable T>
+template <typename R>
+void persisted_container_base<T>::insert_managed(size_type pos, R&& values) {
+    auto& lst = this->list();
+    if constexpr (type_info::ObjectPersistable<value_type>) {
+        for (auto key : object_keys(values)) {
+            lst.insert(pos++, key);
+        }
+    } else {
+        for (auto&& value : values) {
+            lst.insert(pos++, type_info::convert_if_required<value_type>(value));
+        }
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+template <typename R>
+std::vector<ObjKey> persisted_container_base<T>::object_keys(R&& values)
+requires (type_info::ObjectPersistable<typename T::value_type>) {
+    if constexpr (!std::is_lvalue_reference_v<std::ranges::range_reference_t<R>>) {
+        // The range yields its objects by value, e.g. another persisted list, so they are
+        // kept alive while they are added.
+        std::vector<value_type> copies;
+        std::ranges::copy(values, std::back_inserter(copies));
+        return object_keys(copies);
+    } else {
+        std::vector<value_type*> objects;
+        std::vector<value_type*> unmanaged_objects;
+        for (auto& object : values) {
+            objects.push_back(&object);
+            if (!object.m_obj) {
+                unmanaged_objects.push_back(&object);
+            }
+        }
+        if (!unmanaged_objects.empty()) {
+            value_type::schema::add(unmanaged_objects, this->m_obj->get_table()->get_link_target(this->managed), this->m_realm);
+        }
+        std::vector<ObjKey> keys;
+        keys.reserve(objects.size());
+        for (auto object : objects) {
+            keys.push_back(object->m_obj->get_key());
+        }
+        return keys;
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+template <std::ranges::input_range R>
+void persisted_container_base<T>::append_range(R&& values) {
+    if (this->m_obj) {
+        insert_managed(this->list().size(), values);
+    } else {
+        std::ranges::copy(values, std::back_inserter(this->unmanaged));
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+template <std::ranges::input_range R>
+void persisted_container_base<T>::insert(size_type pos, R&& values) {
+    if (this->m_obj) {
+        insert_managed(pos, values);
+    } else {
+        std::ranges::copy(values, std::inserter(this->unmanaged, this->unmanaged.begin() + pos));
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+template <std::ranges::input_range R>
+void persisted_container_base<T>::assign(R&& values) {
+    if (this->m_obj) {
+        // `values` may be a view of this list, so it is read in full before the list is cleared.
+        auto& lst = this->list();
+        if constexpr (type_info::ObjectPersistable<value_type>) {
+            auto keys = object_keys(values);
+            lst.clear();
+            for (auto key : keys) {
+                lst.add(key);
+            }
+        } else {
+            std::vector<value_type> materialized;
+            std::ranges::copy(values, std::back_inserter(materialized));
+            lst.clear();
+            insert_managed(0, materialized);
+        }
+    } else {
+        this->unmanaged.clear();
+        std::ranges::copy(values, std::back_inserter(this->unmanaged));
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+void persisted_container_base<T>::resize(size_type count) {
+    if (this->m_obj) {
+        auto& lst = this->list();
+        auto size = lst.size();
+        if (count < size) {
+            lst.remove(count, size);
+        } else if (count > size) {
+            if constexpr (type_info::ObjectPersistable<value_type>) {
+                if constexpr (value_type::schema::HasPrimaryKeyProperty) {
+                    // Default constructed objects would all share the same primary key.
+                    throw std::logic_error("A list of objects with a primary key cannot grow by resize; append the objects instead");
+                } else {
+                    std::vector<value_type> objects(count - size);
+                    insert_managed(size, objects);
+                }
+            } else {
+                value_type value{};
+                auto core_value = type_info::convert_if_required<value_type>(value);
+                for (; size < count; size++) {
+                    lst.add(core_value);
+                }
+            }
+        }
+    } else {
+        this->unmanaged.resize(count);
+    }
+}
+
 template <realm::type_info::ListPersistable T>
 typename T::value_type persisted_container_base<T>::operator[](typename T::size_type a)
 requires (type_info::PrimitivePersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(this->managed);
+        auto& lst = this->list();
         if constexpr (realm::type_info::BinaryPersistable<typename T::value_type>) {
-            return std::vector<uint8_t>(lst[a].data(), lst[a].data()+lst[a].size());
+            auto binary = lst.get(a);
+            return std::vector<uint8_t>(binary.data(), binary.data() + binary.size());
         } else {
             return static_cast<typename T::value_type>(lst[a]);
         }
@@ -474,8 +1016,8 @@ template <realm::type_info::ListPersistable T>
 typename T::value_type persisted_container_base<T>::operator[](typename T::size_type a)
 requires (type_info::ObjectPersistable<typename T::value_type>) {
     if (this->m_obj) {
-        auto lst = this->m_obj->get_linklist(this->managed);
-        return T::value_type::schema::create(lst.get_object(a), nullptr);
+        auto& lst = this->list();
+        return T::value_type::schema::create(lst.get_object(a), this->m_realm);
     } else {
         return this->unmanaged[a];
     }
@@ -483,6 +1025,35 @@ requires (type_info::ObjectPersistable<typename T::value_type>) {
 
 
 template <realm::type_info::ListPersistable T>
+realm::query<typename T::value_type> persisted_container_base<T>::quantified(ExpressionComparisonType type) {
+    auto path = this->follow(this->managed);
+    if (path.quantifier && *path.quantifier != type) {
+        throw std::logic_error("A query can only pass through lists with one of any(), all() or none()");
+    }
+    path.quantifier = type;
+    return realm::query<typename T::value_type>(*this->query, std::move(path));
+}
+
+template <realm::type_info::ListPersistable T>
+realm::query<typename T::value_type> persisted_container_base<T>::any()
+requires (type_info::ObjectPersistable<typename T::value_type>) {
+    return quantified(ExpressionComparisonType::Any);
+}
+
+template <realm::type_info::ListPersistable T>
+realm::query<typename T::value_type> persisted_container_base<T>::all()
+requires (type_info::ObjectPersistable<typename T::value_type>) {
+    return quantified(ExpressionComparisonType::All);
+}
+
+template <realm::type_info::ListPersistable T>
+realm::query<typename T::value_type> persisted_container_base<T>::none()
+requires (type_info::ObjectPersistable<typename T::value_type>) {
+    return quantified(ExpressionComparisonType::None);
+}
+
+template <typename T>
+requires (type_info::ListPersistable<T> || type_info::SetPersistable<T>)
 struct CollectionCallbackWrapper {
     util::UniqueFunction<void(CollectionChange<T>, std::exception_ptr err)> handler;
     persisted<T>& collection;
@@ -503,42 +1074,273 @@ struct CollectionCallbackWrapper {
 
         }
         else if (!changes.collection_root_was_deleted || !changes.deletions.empty()) {
+            std::vector<CollectionMove> moves;
+            moves.reserve(changes.moves.size());
+            for (auto& move : changes.moves) {
+                moves.push_back({move.from, move.to});
+            }
             handler({&collection,
                 to_vector(changes.deletions),
                 to_vector(changes.insertions),
                 to_vector(changes.modifications),
+                std::move(moves)
             }, nullptr);
         }
     }
-
+
+private:
+    std::vector<u_int64_t> to_vector(const IndexSet& index_set) {
+        auto vector = std::vector<u_int64_t>();
+        for (auto index : index_set.as_indexes()) {
+            vector.push_back(index);
+        }
+        return vector;
+    };
+};
+
+template <realm::type_info::ListPersistable T>
+notification_token persisted_container_base<T>::observe(util::UniqueFunction<void(CollectionChange<T>,
+                                                                                  std::exception_ptr)> handler)
+{
+    if (this->m_obj) {
+        notification_token token;
+        token.m_list = List(this->m_realm, *this->m_obj, this->managed);;
+        token.m_token = token.m_list.add_notification_callback(CollectionCallbackWrapper<T> { std::move(handler), *static_cast<persisted<T>*>(this), false });
+        return token;
+    } else {
+        return {};
+    }
+}
+
+template <realm::type_info::ListPersistable T>
+struct persisted<T> : public persisted_container_base<T> {
+    using persisted_container_base<T>::persisted_container_base;
+    using persisted_container_base<T>::operator=;
+};
+
+// MARK: Persisted Set
+
+/// `persisted<std::set<T>>` is backed by a core Set, which keeps its values sorted, so
+/// membership checks, inserts and removals are O(log n).
+template <realm::type_info::SetPersistable T>
+struct persisted_set_base : public persisted_base<T> {
+    using value_type = typename T::value_type;
+    using persisted_base<T>::persisted_base;
+
+    size_t size() const;
+    /// Adds `value` to the set. Returns false if it was already present.
+    bool insert(const value_type& value);
+    /// Removes `value` from the set. Returns false if it was not present.
+    bool erase(const value_type& value);
+    void clear();
+
+    /// Whether the set contains `value`. In queries, matches objects whose set contains it:
+    /// ```cpp
+    /// realm.objects<Post>().where([](auto& post) { return post.tags.contains("realm"); });
+    /// ```
+    rbool contains(const value_type& value) const;
+
+    notification_token observe(util::UniqueFunction<void(CollectionChange<T>,
+                                                         std::exception_ptr)>);
+
+    /// Make this set property managed
+    /// @param object The parent object
+    /// @param col_key The column key for this property
+    /// @param realm The Realm instance managing the parent.
+    void assign(const Obj& object, const ColKey& col_key, SharedRealm realm);
+private:
+    using core_type = typename type_info::persisted_type<value_type>::type;
+
+    // The core accessor for the managed set, created on first use.
+    Set<core_type>& set() const
+    {
+        if (!m_set) {
+            m_set.emplace(this->m_obj->template get_set<core_type>(this->managed));
+        }
+        return *m_set;
+    }
+
+    mutable std::optional<Set<core_type>> m_set;
+};
+
+template <realm::type_info::SetPersistable T>
+struct persisted<T> : public persisted_set_base<T> {
+    using persisted_set_base<T>::persisted_set_base;
+};
+
+// MARK: Persisted Dictionary
+
+/// `persisted<std::map<std::string, T>>` is backed by a core Dictionary, so lookups,
+/// inserts and removals by key are O(log n).
+template <realm::type_info::DictionaryPersistable T>
+struct persisted_dictionary_base : public persisted_base<T> {
+    using key_type = std::string;
+    using mapped_type = typename T::mapped_type;
+    using persisted_base<T>::persisted_base;
+
+    size_t size() const;
+    /// Sets the value for `key`, adding the key if it is not present.
+    void insert_or_assign(const std::string& key, const mapped_type& value);
+    /// The value for `key`, or `std::nullopt` if the key is not present.
+    std::optional<mapped_type> find(const std::string& key) const;
+    /// Removes `key` and its value. Returns false if the key was not present.
+    bool erase(const std::string& key);
+    void clear();
+
+    /// Whether the dictionary has a value for `key`. In queries, matches objects whose
+    /// dictionary has the key.
+    rbool contains_key(const std::string& key) const;
+    /// Whether any value of the dictionary equals `value`. In queries, matches objects whose
+    /// dictionary has such a value.
+    rbool contains_value(const mapped_type& value) const;
+
+    notification_token observe(util::UniqueFunction<void(DictionaryChange<T>,
+                                                         std::exception_ptr)>);
+
+    /// Make this dictionary property managed
+    /// @param object The parent object
+    /// @param col_key The column key for this property
+    /// @param realm The Realm instance managing the parent.
+    void assign(const Obj& object, const ColKey& col_key, SharedRealm realm);
+private:
+    using core_type = typename type_info::persisted_type<mapped_type>::type;
+
+    static mapped_type from_core(Mixed value)
+    {
+        auto core_value = value.template get<core_type>();
+        if constexpr (type_info::BinaryPersistable<mapped_type>) {
+            return mapped_type(core_value.data(), core_value.data() + core_value.size());
+        } else {
+            return static_cast<mapped_type>(core_value);
+        }
+    }
+
+    // The core accessor for the managed dictionary, created on first use.
+    Dictionary& dictionary() const
+    {
+        if (!m_dictionary) {
+            m_dictionary.emplace(this->m_obj->get_dictionary(this->managed));
+        }
+        return *m_dictionary;
+    }
+
+    mutable std::optional<Dictionary> m_dictionary;
+};
+
+template <realm::type_info::DictionaryPersistable T>
+struct persisted<T> : public persisted_dictionary_base<T> {
+    using persisted_dictionary_base<T>::persisted_dictionary_base;
+};
+
+template <realm::type_info::BinaryPersistable T>
+struct persisted_binary_base;
+
+/// Appends to managed binary properties which have not been written to their objects yet.
+///
+/// Core stores binary values whole, so each append written straight away would copy the entire
+/// value. Appends are instead collected per property and written once, when the property is
+/// read through the same accessor or when the write transaction of its Realm ends.
+struct pending_binary_appends {
+    struct entry {
+        virtual ~entry() = default;
+        virtual void flush() = 0;
+    };
+
+    static void add(const Realm* realm, std::shared_ptr<entry> pending)
+    {
+        s_entries.emplace_back(realm, std::move(pending));
+    }
+
+    /// Writes the pending appends of `realm` to their objects. Called before committing.
+    static void flush(const Realm* realm)
+    {
+        for (auto& pending : take(realm)) {
+            pending->flush();
+        }
+    }
+
+    /// Drops the pending appends of `realm`, e.g. when its write transaction is abandoned.
+    static void discard(const Realm* realm)
+    {
+        take(realm);
+    }
+private:
+    static std::vector<std::shared_ptr<entry>> take(const Realm* realm)
+    {
+        std::vector<std::shared_ptr<entry>> taken;
+        std::erase_if(s_entries, [&](auto& e) {
+            if (e.first != realm) {
+                return false;
+            }
+            taken.push_back(std::move(e.second));
+            return true;
+        });
+        return taken;
+    }
+
+    static inline thread_local std::vector<std::pair<const Realm*, std::shared_ptr<entry>>> s_entries;
+};
+
+/// Builds the contents of a binary property in pieces, and writes them to the object
+/// with a single write when it is closed. Obtained from `persisted<std::vector<uint8_t>>::writer()`.
+///
+/// Nothing is written until `close()` is called; a writer destroyed without being closed,
+/// e.g. while an exception unwinds, discards its data. For a managed property `close()`
+/// must be called within the write transaction the writer was created in.
+/// ```cpp
+/// realm.write([&] {
+///     auto writer = attachment.data.writer();
+///     writer.reserve(file_size);
+///     while (auto chunk = read_chunk(file)) {
+///         writer.write(*chunk);
+///     }
+///     writer.close();
+/// });
+/// ```
+template <realm::type_info::BinaryPersistable T>
+class blob_writer {
+public:
+    blob_writer(const blob_writer&) = delete;
+    blob_writer& operator=(const blob_writer&) = delete;
+    blob_writer(blob_writer&& other) noexcept
+    : m_buffer(std::move(other.m_buffer))
+    , m_property(std::exchange(other.m_property, nullptr))
+    {
+    }
+
+    /// Reserves space for `size` bytes in total, avoiding reallocations while writing.
+    void reserve(size_t size)
+    {
+        m_buffer.reserve(size);
+    }
+
+    /// Appends `bytes` to the data.
+    void write(std::span<const uint8_t> bytes)
+    {
+        m_buffer.insert(m_buffer.end(), bytes.begin(), bytes.end());
+    }
+
+    /// Writes the data to the property. Further writes are ignored.
+    /// Throws `std::length_error` if the data is larger than a managed property can hold,
+    /// in which case the property is left unchanged.
+    void close()
+    {
+        if (m_property) {
+            m_property->set_data(std::move(m_buffer));
+            m_property = nullptr;
+        }
+    }
 private:
-    std::vector<u_int64_t> to_vector(const IndexSet& index_set) {
-        auto vector = std::vector<u_int64_t>();
-        for (auto index : index_set.as_indexes()) {
-            vector.push_back(index);
-        }
-        return vector;
-    };
-};
+    friend struct persisted_binary_base<T>;
 
-template <realm::type_info::ListPersistable T>
-notification_token persisted_container_base<T>::observe(util::UniqueFunction<void(CollectionChange<T>,
-                                                                                  std::exception_ptr)> handler)
-{
-    if (this->m_obj) {
-        notification_token token;
-        token.m_list = List(this->m_realm, *this->m_obj, this->managed);;
-        token.m_token = token.m_list.add_notification_callback(CollectionCallbackWrapper<T> { std::move(handler), *static_cast<persisted<T>*>(this), false });
-        return token;
-    } else {
-        return {};
+    blob_writer(persisted_binary_base<T>& property, T&& initial)
+    : m_buffer(std::move(initial))
+    , m_property(&property)
+    {
     }
-}
 
-template <realm::type_info::ListPersistable T>
-struct persisted<T> : public persisted_container_base<T> {
-    using persisted_container_base<T>::persisted_container_base;
-    using persisted_container_base<T>::operator=;
+    T m_buffer;
+    persisted_binary_base<T>* m_property;
 };
 
 template <realm::type_info::BinaryPersistable T>
@@ -546,8 +1348,14 @@ struct persisted_binary_base : public persisted_base<T> {
     using value_type = typename T::value_type;
     using size_type = typename T::size_type;
 
+    T operator*() const
+    {
+        flush();
+        return persisted_base<T>::operator*();
+    }
     typename T::value_type operator[](size_type pos)
     {
+        flush();
         if (this->m_obj) {
             return this->m_obj->template get<BinaryData>(this->managed)[pos];
         } else {
@@ -555,15 +1363,119 @@ struct persisted_binary_base : public persisted_base<T> {
         }
     }
     void push_back(value_type a)
+    {
+        append(std::span<const uint8_t>(&a, 1));
+    }
+    /// Appends `bytes` to the data.
+    ///
+    /// On a managed property the appends made within a write transaction are collected and
+    /// written to the object once, when the property is next read through this accessor or
+    /// when the transaction ends, so building a value piece by piece takes linear time.
+    /// Until then other accessors of the same object, and queries, see the previous value.
+    void append(std::span<const uint8_t> bytes)
+    {
+        if (this->m_obj) {
+            auto& data = pending().data;
+            if (data.size() + bytes.size() > Table::max_binary_size) {
+                throw_too_large(data.size() + bytes.size());
+            }
+            data.insert(data.end(), bytes.begin(), bytes.end());
+            if (!this->m_realm) {
+                // Without its Realm the end of the transaction can't be observed, so the
+                // data is written straight away.
+                flush();
+            }
+        } else {
+            this->unmanaged.insert(this->unmanaged.end(), bytes.begin(), bytes.end());
+        }
+    }
+    /// Reserves space for `size` bytes in total, avoiding reallocations while appending.
+    void reserve(size_type size)
+    {
+        if (!this->m_obj) {
+            this->unmanaged.reserve(size);
+        } else if (this->m_realm) {
+            pending().data.reserve(size);
+        }
+    }
+    size_type size() const
+    {
+        if (m_pending && !m_pending->written) {
+            return m_pending->data.size();
+        }
+        if (this->m_obj) {
+            return this->m_obj->template get<BinaryData>(this->managed).size();
+        } else {
+            return this->unmanaged.size();
+        }
+    }
+    /// A writer which appends to the current data, and writes the result once when closed.
+    blob_writer<T> writer()
+    {
+        flush();
+        return blob_writer<T>(*this, **this);
+    }
+private:
+    friend class blob_writer<T>;
+
+    struct pending_append : pending_binary_appends::entry {
+        Obj object;
+        ColKey column_key;
+        T data;
+        bool written = false;
+
+        void flush() override
+        {
+            if (std::exchange(written, true)) {
+                return;
+            }
+            if (object.is_valid()) {
+                object.set(column_key, type_info::convert_if_required<T>(data));
+            }
+            T().swap(data);
+        }
+    };
+
+    // The appends not yet written to the object, starting from the current value.
+    pending_append& pending()
+    {
+        if (!m_pending || m_pending->written) {
+            auto pending = std::make_shared<pending_append>();
+            pending->object = *this->m_obj;
+            pending->column_key = this->managed;
+            pending->data = persisted_base<T>::operator*();
+            if (this->m_realm) {
+                pending_binary_appends::add(this->m_realm.get(), pending);
+            }
+            m_pending = std::move(pending);
+        }
+        return *m_pending;
+    }
+
+    void flush() const
+    {
+        if (auto pending = std::exchange(m_pending, nullptr)) {
+            pending->flush();
+        }
+    }
+
+    [[noreturn]] static void throw_too_large(size_t size)
+    {
+        throw std::length_error("Binary data of " + std::to_string(size) + " bytes exceeds the maximum of "
+                                + std::to_string(Table::max_binary_size) + " bytes");
+    }
+
+    mutable std::shared_ptr<pending_append> m_pending;
+
+    void set_data(T&& data)
     {
         if (this->m_obj) {
-            BinaryData data = this->m_obj->template get<BinaryData>(this->managed);
-            std::string data_tmp = data.data();
-            data_tmp += a;
-            data = BinaryData(data_tmp);
-            this->m_obj->set(this->managed, data);
+            if (data.size() > Table::max_binary_size) {
+                throw_too_large(data.size());
+            }
+            this->m_obj->set(this->managed, type_info::convert_if_required<T>(data));
         } else {
-            this->unmanaged.push_back(a);
+            this->unmanaged = std::move(data);
         }
     }
 };
@@ -609,6 +1521,10 @@ persisted_base<T>::~persisted_base()
         if (!m_obj) {
             unmanaged.clear();
         }
+    } else if constexpr (type_info::SetPersistable<T> || type_info::DictionaryPersistable<T>) {
+        if (!m_obj) {
+            std::destroy_at(&unmanaged);
+        }
     } else if constexpr (realm::type_info::property_type<T>() == PropertyType::String) {
         using std::string;
         if (!m_obj) {
@@ -672,6 +1588,7 @@ template <realm::type_info::Persistable T>
 persisted_base<T>& persisted_base<T>::operator=(const persisted_base& o) {
     if (auto obj = o.m_obj) {
         m_obj = obj;
+        m_realm = o.m_realm;
         new (&managed) ColKey(o.managed);
     } else {
         new (&unmanaged) T(o.unmanaged);
@@ -683,6 +1600,7 @@ template <realm::type_info::Persistable T>
 persisted_base<T>& persisted_base<T>::operator=(persisted_base&& o) {
     if (o.m_obj) {
         m_obj = o.m_obj;
+        m_realm = o.m_realm;
         new (&managed) ColKey(std::move(o.managed));
     } else {
         new (&unmanaged) T(std::move(o.unmanaged));
@@ -696,7 +1614,7 @@ T persisted_base<T>::operator *() const
     if (m_obj) {
         if constexpr (type_info::OptionalPersistable<T>) {
             if constexpr (type_info::ObjectPersistable<typename T::value_type>) {
-                return T::value_type::schema::create(m_obj->get_linked_object(managed), nullptr);
+                return T::value_type::schema::create(m_obj->get_linked_object(managed), m_realm);
             } else {
                 auto value = m_obj->template get<type>(managed);
                 // convert optionals
@@ -709,18 +1627,50 @@ T persisted_base<T>::operator *() const
         } else {
             if constexpr (type_info::ListPersistable<T>) {
                 T v;
-                auto lst = m_obj->template get_list_values<typename type_info::persisted_type<typename T::value_type>::type>(managed);
-                for (size_t i; i < lst.size(); i++) {
-                    if constexpr (type_info::ObjectPersistable<typename T::value_type>) {
-                        auto obj = lst.get_object(i);
-                        v.push_back(T::value_type::schema::create(obj, obj.get_table(), nullptr));
+                if constexpr (type_info::ObjectPersistable<typename T::value_type>) {
+                    auto lst = m_obj->get_linklist(managed);
+                    v.reserve(lst.size());
+                    for (size_t i = 0; i < lst.size(); i++) {
+                        v.push_back(T::value_type::schema::create(lst.get_object(i), m_realm));
+                    }
+                } else {
+                    auto lst = m_obj->template get_list<typename type_info::persisted_type<typename T::value_type>::type>(managed);
+                    v.reserve(lst.size());
+                    for (size_t i = 0; i < lst.size(); i++) {
+                        if constexpr (type_info::BinaryPersistable<typename T::value_type>) {
+                            auto binary = lst.get(i);
+                            v.emplace_back(binary.data(), binary.data() + binary.size());
+                        } else {
+                            v.push_back(static_cast<typename T::value_type>(lst.get(i)));
+                        }
+                    }
+                }
+                return v;
+            } else if constexpr (type_info::SetPersistable<T>) {
+                T v;
+                auto set = m_obj->template get_set<typename type_info::persisted_type<typename T::value_type>::type>(managed);
+                for (size_t i = 0; i < set.size(); i++) {
+                    if constexpr (type_info::BinaryPersistable<typename T::value_type>) {
+                        auto binary = set.get(i);
+                        v.emplace_hint(v.end(), binary.data(), binary.data() + binary.size());
                     } else {
-                        v.push_back(static_cast<typename T::value_type>(lst[i]));
+                        v.emplace_hint(v.end(), static_cast<typename T::value_type>(set.get(i)));
+                    }
+                }
+                return v;
+            } else if constexpr (type_info::DictionaryPersistable<T>) {
+                T v;
+                auto dictionary = m_obj->get_dictionary(managed);
+                for (auto [key, value] : dictionary) {
+                    auto core_value = value.template get<typename type_info::persisted_type<typename T::mapped_type>::type>();
+                    if constexpr (type_info::BinaryPersistable<typename T::mapped_type>) {
+                        v.emplace(key.get_string(), typename T::mapped_type(core_value.data(), core_value.data() + core_value.size()));
+                    } else {
+                        v.emplace(key.get_string(), static_cast<typename T::mapped_type>(core_value));
                     }
                 }
-
                 return v;
-            } if constexpr (std::is_same_v<realm::BinaryData, type>) {
+            } else if constexpr (std::is_same_v<realm::BinaryData, type>) {
                 realm::BinaryData binary = m_obj->template get<type>(managed);
                 return std::vector<u_int8_t>(binary.data(), binary.data() + binary.size());
             } else {
@@ -759,6 +1709,10 @@ class rbool {
 
     template <realm::type_info::NonContainerPersistable T>
     friend struct persisted_noncontainer_base;
+    template <realm::type_info::SetPersistable T>
+    friend struct persisted_set_base;
+    template <realm::type_info::DictionaryPersistable T>
+    friend struct persisted_dictionary_base;
     template <typename T>
     friend struct results;
 
@@ -794,13 +1748,18 @@ inline rbool operator ||(const rbool& lhs, const rbool& rhs) {
         lhs.q = lhs.q || rhs.q;
         return lhs;
     }
-    return lhs.b && rhs.b;
+    return lhs.b || rhs.b;
 }
 
 template <realm::type_info::Persistable T>
 rbool operator==(const persisted<T>& a, const T& b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain) {
+                return {a.query_column() == type_info::convert_if_required<T>(b)};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.equal(a.managed, type_info::convert_if_required<T>(b));
         return {std::move(query)};
@@ -812,6 +1771,11 @@ template <realm::type_info::Persistable T>
 rbool operator==(const persisted<T>& a, const persisted<T>& b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain || b.link_chain) {
+                return {a.query_column() == b.query_column()};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.equal(a.managed, b.managed);
         return {std::move(query)};
@@ -823,6 +1787,11 @@ template <realm::type_info::Persistable T>
 rbool operator!=(const persisted<T>& a, const T& b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain) {
+                return {a.query_column() != type_info::convert_if_required<T>(b)};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.not_equal(a.managed, type_info::convert_if_required<T >(b));
         return {std::move(query)};
@@ -834,6 +1803,11 @@ template <realm::type_info::Persistable T>
 rbool operator!=(const persisted<T>& a, const persisted<T>& b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain || b.link_chain) {
+                return {a.query_column() != b.query_column()};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.not_equal(a.managed, b.managed);
         return {std::move(query)};
@@ -844,6 +1818,11 @@ template <realm::type_info::Persistable T>
 rbool operator==(const persisted<T>& a, const char* b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain) {
+                return {a.query_column() == StringData(b)};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.equal(a.managed, b);
         return {std::move(query)};
@@ -854,6 +1833,11 @@ template <realm::type_info::Persistable T>
 rbool operator!=(const persisted<T>& a, const char* b) requires (Equatable<T>)
 {
     if (a.should_detect_usage_for_queries) {
+        if constexpr (!type_info::OptionalObjectPersistable<T>) {
+            if (a.link_chain) {
+                return {a.query_column() != StringData(b)};
+            }
+        }
         auto query = Query(a.query->get_table());
         query.not_equal(a.managed, b);
         return {std::move(query)};
@@ -926,6 +1910,9 @@ void persisted_noncontainer_base<T>::operator ++() requires (type_info::AddAssig
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator <(const T& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain) {
+            return {this->query_column() < type_info::convert_if_required<T>(a)};
+        }
         auto query = Query(this->query->get_table());
         query.less(this->managed, type_info::convert_if_required<T >(a));
         return {std::move(query)};
@@ -935,6 +1922,9 @@ rbool persisted_noncontainer_base<T>::operator <(const T& a) requires (type_info
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator >(const T& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain) {
+            return {this->query_column() > type_info::convert_if_required<T>(a)};
+        }
         auto query = Query(this->query->get_table());
         query.greater(this->managed, type_info::convert_if_required<T >(a));
         return {std::move(query)};
@@ -944,6 +1934,9 @@ rbool persisted_noncontainer_base<T>::operator >(const T& a) requires (type_info
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator <=(const T& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain) {
+            return {this->query_column() <= type_info::convert_if_required<T>(a)};
+        }
         auto query = Query(this->query->get_table());
         query.less_equal(this->managed, type_info::convert_if_required<T >(a));
         return {std::move(query)};
@@ -953,6 +1946,9 @@ rbool persisted_noncontainer_base<T>::operator <=(const T& a) requires (type_inf
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator >=(const T& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain) {
+            return {this->query_column() >= type_info::convert_if_required<T>(a)};
+        }
         auto query = Query(this->query->get_table());
         query.greater_equal(this->managed, type_info::convert_if_required<T >(a));
         return {std::move(query)};
@@ -963,6 +1959,9 @@ rbool persisted_noncontainer_base<T>::operator >=(const T& a) requires (type_inf
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator <(const persisted<T>& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain || a.link_chain) {
+            return {this->query_column() < a.query_column()};
+        }
         auto query = Query(this->query->get_table());
         query.less(this->managed, a.managed);
         return {std::move(query)};
@@ -972,6 +1971,9 @@ rbool persisted_noncontainer_base<T>::operator <(const persisted<T>& a) requires
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator >(const persisted<T>& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain || a.link_chain) {
+            return {this->query_column() > a.query_column()};
+        }
         auto query = Query(this->query->get_table());
         query.greater(this->managed, a.managed);
         return {std::move(query)};
@@ -981,6 +1983,9 @@ rbool persisted_noncontainer_base<T>::operator >(const persisted<T>& a) requires
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator <=(const persisted<T>& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain || a.link_chain) {
+            return {this->query_column() <= a.query_column()};
+        }
         auto query = Query(this->query->get_table());
         query.less_equal(this->managed, a.managed);
         return {std::move(query)};
@@ -990,6 +1995,9 @@ rbool persisted_noncontainer_base<T>::operator <=(const persisted<T>& a) require
 template <realm::type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::operator >=(const persisted<T>& a) requires (type_info::Comparable<T>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain || a.link_chain) {
+            return {this->query_column() >= a.query_column()};
+        }
         auto query = Query(this->query->get_table());
         query.greater_equal(this->managed, a.managed);
         return {std::move(query)};
@@ -1000,6 +2008,9 @@ rbool persisted_noncontainer_base<T>::operator >=(const persisted<T>& a) require
 template <type_info::NonContainerPersistable T>
 rbool persisted_noncontainer_base<T>::contains(const char *str) requires(std::is_same_v<T, std::string>) {
     if (this->should_detect_usage_for_queries) {
+        if (this->link_chain) {
+            return {this->query_column().contains(StringData(str))};
+        }
         auto query = Query(this->query->get_table());
         query.contains(this->managed, StringData(str));
         return {std::move(query)};
@@ -1011,9 +2022,106 @@ rbool persisted_noncontainer_base<T>::contains(const char *str) requires(std::is
     }
 }
 
+template <type_info::NonContainerPersistable T>
+rbool persisted_noncontainer_base<T>::matches(const char *terms) requires(std::is_same_v<T, std::string>) {
+    std::vector<std::string_view> tokens;
+    std::string_view remaining(terms);
+    while (!remaining.empty()) {
+        auto start = remaining.find_first_not_of(" \t\n\r");
+        if (start == std::string_view::npos) {
+            break;
+        }
+        remaining.remove_prefix(start);
+        auto end = std::min(remaining.find_first_of(" \t\n\r"), remaining.size());
+        tokens.push_back(remaining.substr(0, end));
+        remaining.remove_prefix(end);
+    }
+
+    if (this->should_detect_usage_for_queries) {
+        this->check_single_comparison("matches()", tokens.size());
+        auto query = Query(this->query->get_table());
+        for (auto& token : tokens) {
+            if (this->link_chain) {
+                query.and_query(this->query_column().contains(StringData(token.data(), token.size()), false));
+            } else {
+                query.contains(this->managed, StringData(token.data(), token.size()), false);
+            }
+        }
+        return {std::move(query)};
+    }
+
+    // The same case folding as core's case-insensitive `contains`, so that managed and
+    // unmanaged objects agree with the query results.
+    auto value = **this;
+    return std::all_of(tokens.begin(), tokens.end(), [&value](auto& token) {
+        auto needle = StringData(token.data(), token.size());
+        auto upper = case_map(needle, true);
+        auto lower = case_map(needle, false);
+        if (!upper || !lower) {
+            return false;
+        }
+        return search_case_fold(StringData(value), upper->c_str(), lower->c_str(), needle.size()) != realm::npos;
+    });
+}
+
+template <type_info::NonContainerPersistable T>
+rbool persisted_noncontainer_base<T>::in(std::span<const T> values) requires (Equatable<T>) {
+    if (this->should_detect_usage_for_queries) {
+        if (values.empty()) {
+            return {Query(this->query->get_table(), std::unique_ptr<Expression>(new FalseExpression))};
+        }
+        this->check_single_comparison("in()", values.size(), true);
+        auto query = Query(this->query->get_table());
+        query.group();
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i) {
+                query.Or();
+            }
+            if (this->link_chain) {
+                query.and_query(this->query_column() == type_info::convert_if_required<T>(values[i]));
+            } else {
+                query.equal(this->managed, type_info::convert_if_required<T>(values[i]));
+            }
+        }
+        query.end_group();
+        return {std::move(query)};
+    }
+    return std::find(values.begin(), values.end(), **this) != values.end();
+}
+
+template <type_info::NonContainerPersistable T>
+rbool persisted_noncontainer_base<T>::between(const T& lower, const T& upper) requires (type_info::Comparable<T>) {
+    if (this->should_detect_usage_for_queries) {
+        this->check_single_comparison("between()", 2);
+        auto query = Query(this->query->get_table());
+        if (this->link_chain) {
+            query.and_query(this->query_column() >= type_info::convert_if_required<T>(lower));
+            query.and_query(this->query_column() <= type_info::convert_if_required<T>(upper));
+        } else {
+            query.greater_equal(this->managed, type_info::convert_if_required<T>(lower));
+            query.less_equal(this->managed, type_info::convert_if_required<T>(upper));
+        }
+        return {std::move(query)};
+    }
+    auto value = **this;
+    return value >= lower && value <= upper;
+}
+
+template <type_info::NonContainerPersistable T>
+link_proxy<typename T::value_type> persisted_noncontainer_base<T>::operator->() requires (type_info::OptionalObjectPersistable<T>) {
+    if (this->should_detect_usage_for_queries) {
+        return link_proxy<typename T::value_type>(*this->query, this->follow(this->managed));
+    }
+    if (this->m_obj && this->m_obj->is_null(this->managed)) {
+        return link_proxy<typename T::value_type>(std::nullopt);
+    }
+    return link_proxy<typename T::value_type>(**this);
+}
+
 template <realm::type_info::Persistable T>
-void persisted_base<T>::assign(const Obj& object, const ColKey& col_key) {
+void persisted_base<T>::assign(const Obj& object, const ColKey& col_key, SharedRealm realm) {
     m_obj = object;
+    m_realm = std::move(realm);
     new (&managed) ColKey(col_key);
 }
 
@@ -1021,9 +2129,210 @@ template <realm::type_info::ListPersistable T>
 void persisted_container_base<T>::assign(const Obj& object, const ColKey& col_key, SharedRealm realm) {
     this->m_obj = object;
     this->m_realm = realm;
+    m_list.reset();
+    new (&this->managed) ColKey(col_key);
+}
+
+// MARK: Set
+
+template <realm::type_info::SetPersistable T>
+void persisted_set_base<T>::assign(const Obj& object, const ColKey& col_key, SharedRealm realm) {
+    this->m_obj = object;
+    this->m_realm = realm;
+    m_set.reset();
+    new (&this->managed) ColKey(col_key);
+}
+
+template <realm::type_info::SetPersistable T>
+size_t persisted_set_base<T>::size() const {
+    if (this->m_obj) {
+        return set().size();
+    } else {
+        return this->unmanaged.size();
+    }
+}
+
+template <realm::type_info::SetPersistable T>
+bool persisted_set_base<T>::insert(const value_type& value) {
+    if (this->m_obj) {
+        return set().insert(type_info::convert_if_required<value_type>(value)).second;
+    } else {
+        return this->unmanaged.insert(value).second;
+    }
+}
+
+template <realm::type_info::SetPersistable T>
+bool persisted_set_base<T>::erase(const value_type& value) {
+    if (this->m_obj) {
+        return set().erase(type_info::convert_if_required<value_type>(value)).second;
+    } else {
+        return this->unmanaged.erase(value) > 0;
+    }
+}
+
+template <realm::type_info::SetPersistable T>
+void persisted_set_base<T>::clear() {
+    if (this->m_obj) {
+        set().clear();
+    } else {
+        this->unmanaged.clear();
+    }
+}
+
+template <realm::type_info::SetPersistable T>
+rbool persisted_set_base<T>::contains(const value_type& value) const {
+    if (this->should_detect_usage_for_queries) {
+        return {this->query_column() == type_info::convert_if_required<value_type>(value)};
+    } else if (this->m_obj) {
+        return set().find(type_info::convert_if_required<value_type>(value)) != realm::npos;
+    } else {
+        return this->unmanaged.contains(value);
+    }
+}
+
+template <realm::type_info::SetPersistable T>
+notification_token persisted_set_base<T>::observe(util::UniqueFunction<void(CollectionChange<T>,
+                                                                            std::exception_ptr)> handler)
+{
+    if (this->m_obj) {
+        notification_token token;
+        token.m_set = object_store::Set(this->m_realm, *this->m_obj, this->managed);
+        token.m_token = token.m_set.add_notification_callback(CollectionCallbackWrapper<T> { std::move(handler), *static_cast<persisted<T>*>(this), false });
+        return token;
+    } else {
+        return {};
+    }
+}
+
+// MARK: Dictionary
+
+template <realm::type_info::DictionaryPersistable T>
+struct DictionaryCallbackWrapper {
+    util::UniqueFunction<void(DictionaryChange<T>, std::exception_ptr err)> handler;
+    persisted<T>& collection;
+
+    void operator()(realm::DictionaryChangeSet changes, std::exception_ptr err) {
+        if (err) {
+            handler({&collection}, err);
+            return;
+        }
+        handler({&collection,
+            to_keys(changes.deletions),
+            to_keys(changes.insertions),
+            to_keys(changes.modifications),
+            changes.collection_root_was_deleted
+        }, nullptr);
+    }
+
+private:
+    std::vector<std::string> to_keys(const std::vector<Mixed>& keys) {
+        std::vector<std::string> vector;
+        vector.reserve(keys.size());
+        for (auto& key : keys) {
+            vector.emplace_back(key.get_string());
+        }
+        return vector;
+    }
+};
+
+template <realm::type_info::DictionaryPersistable T>
+void persisted_dictionary_base<T>::assign(const Obj& object, const ColKey& col_key, SharedRealm realm) {
+    this->m_obj = object;
+    this->m_realm = realm;
+    m_dictionary.reset();
     new (&this->managed) ColKey(col_key);
 }
 
+template <realm::type_info::DictionaryPersistable T>
+size_t persisted_dictionary_base<T>::size() const {
+    if (this->m_obj) {
+        return dictionary().size();
+    } else {
+        return this->unmanaged.size();
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+void persisted_dictionary_base<T>::insert_or_assign(const std::string& key, const mapped_type& value) {
+    if (this->m_obj) {
+        dictionary().insert(StringData(key), Mixed(type_info::convert_if_required<mapped_type>(value)));
+    } else {
+        this->unmanaged.insert_or_assign(key, value);
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+std::optional<typename T::mapped_type> persisted_dictionary_base<T>::find(const std::string& key) const {
+    if (this->m_obj) {
+        if (auto value = dictionary().try_get(StringData(key))) {
+            return from_core(*value);
+        }
+    } else if (auto it = this->unmanaged.find(key); it != this->unmanaged.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+template <realm::type_info::DictionaryPersistable T>
+bool persisted_dictionary_base<T>::erase(const std::string& key) {
+    if (this->m_obj) {
+        auto& dictionary = this->dictionary();
+        if (!dictionary.contains(StringData(key))) {
+            return false;
+        }
+        dictionary.erase(StringData(key));
+        return true;
+    } else {
+        return this->unmanaged.erase(key) > 0;
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+void persisted_dictionary_base<T>::clear() {
+    if (this->m_obj) {
+        dictionary().clear();
+    } else {
+        this->unmanaged.clear();
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+rbool persisted_dictionary_base<T>::contains_key(const std::string& key) const {
+    if (this->should_detect_usage_for_queries) {
+        return {this->query_column().keys() == Mixed(StringData(key))};
+    } else if (this->m_obj) {
+        return dictionary().contains(StringData(key));
+    } else {
+        return this->unmanaged.contains(key);
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+rbool persisted_dictionary_base<T>::contains_value(const mapped_type& value) const {
+    if (this->should_detect_usage_for_queries) {
+        return {this->query_column() == Mixed(type_info::convert_if_required<mapped_type>(value))};
+    } else if (this->m_obj) {
+        return dictionary().find_any(Mixed(type_info::convert_if_required<mapped_type>(value))) != realm::npos;
+    } else {
+        return std::ranges::any_of(this->unmanaged, [&value](auto& pair) { return pair.second == value; });
+    }
+}
+
+template <realm::type_info::DictionaryPersistable T>
+notification_token persisted_dictionary_base<T>::observe(util::UniqueFunction<void(DictionaryChange<T>,
+                                                                                   std::exception_ptr)> handler)
+{
+    if (this->m_obj) {
+        notification_token token;
+        token.m_dictionary = object_store::Dictionary(this->m_realm, *this->m_obj, this->managed);
+        token.m_token = token.m_dictionary.add_key_based_notification_callback(
+                DictionaryCallbackWrapper<T> { std::move(handler), *static_cast<persisted<T>*>(this) });
+        return token;
+    } else {
+        return {};
+    }
+}
+
 template <realm::type_info::Persistable T>
 std::ostream& operator<< (std::ostream& stream, const persisted<T>& value)
 {
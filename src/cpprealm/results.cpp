@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2022 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <cpprealm/sdk.hpp>
+
+#include <realm/parser/driver.hpp>
+
+namespace realm {
+
+struct parsed_query::impl {
+    std::vector<Mixed> values;
+    std::optional<query_parser::MixedArguments> arguments;
+    std::unique_ptr<query_parser::ParserDriver> driver;
+};
+
+parsed_query::parsed_query(TableRef table, const std::string& query_string)
+: m_impl(std::make_unique<impl>())
+{
+    m_impl->arguments.emplace(m_impl->values);
+    m_impl->driver = std::make_unique<query_parser::ParserDriver>(table, *m_impl->arguments, query_parser::KeyPathMapping());
+    m_impl->driver->parse(query_string);
+}
+
+parsed_query::~parsed_query() = default;
+
+Query parsed_query::bind(std::vector<Mixed> arguments)
+{
+    m_impl->values = std::move(arguments);
+    // The driver holds a reference to `arguments`, so they are rebuilt
+    // in place to pick up the new argument count.
+    m_impl->arguments.emplace(m_impl->values);
+    auto& driver = *m_impl->driver;
+    auto query = driver.result->visit(&driver);
+    if (driver.ordering) {
+        query.set_ordering(driver.ordering->visit(&driver));
+    }
+    return query;
+}
+
+}
@@ -20,12 +20,87 @@
 #define realm_results_hpp
 
 #include <any>
+#include <list>
+#include <memory>
+#include <unordered_map>
 
+#include <cpprealm/notifications.hpp>
 #include <cpprealm/type_info.hpp>
 #include <realm/object-store/results.hpp>
+#include <realm/parser/query_parser.hpp>
 #include <realm/query.hpp>
 namespace realm {
 
+/// An RQL query string which has been parsed once, and whose `$n` arguments
+/// are bound each time it is executed.
+///
+/// The parse tree refers to the table it was parsed against, so a parsed query is
+/// confined to the thread of the Realm which owns that table.
+struct parsed_query {
+    parsed_query(TableRef table, const std::string& query_string);
+    ~parsed_query();
+
+    parsed_query(const parsed_query&) = delete;
+    parsed_query& operator=(const parsed_query&) = delete;
+
+    /// Builds a core `Query` from the parse tree with `arguments` substituted for `$0...$n`.
+    Query bind(std::vector<Mixed> arguments);
+private:
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+};
+
+/// A least recently used cache of parsed RQL queries, keyed by object type and query string.
+///
+/// Used by `results<T>::where(const std::string&, std::vector<Mixed>)` so that repeated
+/// query shapes are only parsed once per `db`. The cache is not synchronized: like the
+/// Realm it belongs to, it must only be used from the thread the `db` was opened on.
+struct query_cache {
+    struct statistics {
+        size_t hits = 0;
+        size_t misses = 0;
+
+        double hit_rate() const noexcept {
+            return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0;
+        }
+    };
+
+    explicit query_cache(size_t capacity) : m_capacity(capacity) {}
+
+    std::shared_ptr<parsed_query> get(TableRef table, const std::string& query_string)
+    {
+        auto key = std::string(table->get_name()) + '\0' + query_string;
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            m_statistics.hits++;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return it->second->second;
+        }
+
+        m_statistics.misses++;
+        auto parsed = std::make_shared<parsed_query>(table, query_string);
+        if (m_capacity == 0) {
+            return parsed;
+        }
+        if (m_entries.size() == m_capacity) {
+            m_entries.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+        m_lru.emplace_front(key, parsed);
+        m_entries.emplace(std::move(key), m_lru.begin());
+        return parsed;
+    }
+
+    const statistics& stats() const noexcept {
+        return m_statistics;
+    }
+private:
+    using entry = std::pair<std::string, std::shared_ptr<parsed_query>>;
+    size_t m_capacity;
+    std::list<entry> m_lru;
+    std::unordered_map<std::string, std::list<entry>::iterator> m_entries;
+    statistics m_statistics;
+};
+
 
 template <type_info::ObjectPersistable T>
 struct query : public T {
@@ -40,6 +115,115 @@ public:
             (set_managed((this->*props.ptr), schema.property_for_name(props.name)->column_key), ...);
         }, T::schema::properties);
     }
+    /// A query object for the target of `path`, whose properties are compared through the links.
+    query(Query& query, link_path&& path) : m_link_path(std::move(path)) {
+        auto table = m_link_path.chain().get_current_table();
+        std::apply([&](auto&&... props) {
+            ((this->*props.ptr).prepare_for_query(query, &m_link_path), ...);
+            (set_managed((this->*props.ptr), table->get_column_key(props.name)), ...);
+        }, T::schema::properties);
+    }
+    // Properties hold pointers to the builder and the link chain, so the query object must not move.
+    query(const query&) = delete;
+    query& operator=(const query&) = delete;
+private:
+    link_path m_link_path;
+};
+
+template <type_info::ObjectPersistable T>
+struct prepared_query;
+
+/// A type-safe query built from a lambda whose query shape is captured once.
+///
+/// The query object handed to the lambda, and the column keys of its properties, are
+/// resolved on first use and reused afterwards. Each execution only reruns the lambda
+/// with the new arguments:
+/// ```cpp
+/// auto older_than = realm::compile_query<Person>([](auto& person, auto& age) {
+///     return person.age > age;
+/// });
+/// auto adults = realm.objects<Person>().where(older_than, 18);
+/// ```
+template <type_info::ObjectPersistable T, typename Fn>
+struct compiled_query {
+    explicit compiled_query(Fn fn) : m_fn(std::move(fn)) {}
+private:
+    template <typename>
+    friend struct results;
+
+    struct state {
+        ConstTableRef table;
+        Query builder;
+        std::optional<query<T>> object;
+    };
+
+    query<T>& object_for(const SharedRealm& realm, ConstTableRef table)
+    {
+        if (!m_state || m_state->table != table) {
+            // The query object holds a pointer to the builder, so it must not move.
+            m_state = std::make_unique<state>();
+            m_state->table = table;
+            m_state->builder = Query(table);
+            m_state->object.emplace(m_state->builder, ObjectSchema(*realm->schema().find(T::schema::name)));
+        }
+        return *m_state->object;
+    }
+
+    Fn m_fn;
+    std::unique_ptr<state> m_state;
+};
+
+template <type_info::ObjectPersistable T, typename Fn>
+compiled_query<T, std::decay_t<Fn>> compile_query(Fn&& fn)
+{
+    return compiled_query<T, std::decay_t<Fn>>(std::forward<Fn>(fn));
+}
+
+template <typename T, StringLiteral>
+struct linking_objects;
+
+#if QT_CORE_LIB
+namespace qt {
+template <type_info::ObjectPersistable T>
+class results_model;
+}
+#endif
+
+template <typename T>
+struct ResultsCallbackWrapper {
+    util::UniqueFunction<void(ResultsChange<T>, std::exception_ptr err)> handler;
+    const results<T>* collection;
+
+    void operator()(realm::CollectionChangeSet const& changes, std::exception_ptr err) {
+        if (err) {
+            handler({collection}, err);
+            return;
+        }
+        if (changes.empty()) {
+            handler({collection}, nullptr);
+            return;
+        }
+        std::vector<CollectionMove> moves;
+        moves.reserve(changes.moves.size());
+        for (auto& move : changes.moves) {
+            moves.push_back({move.from, move.to});
+        }
+        handler({collection,
+            to_vector(changes.deletions),
+            to_vector(changes.insertions),
+            to_vector(changes.modifications_new),
+            std::move(moves)
+        }, nullptr);
+    }
+
+private:
+    std::vector<uint64_t> to_vector(const IndexSet& index_set) {
+        auto vector = std::vector<uint64_t>();
+        for (auto index : index_set.as_indexes()) {
+            vector.push_back(index);
+        }
+        return vector;
+    };
 };
 
 template <typename T>
@@ -116,10 +300,22 @@ struct results {
         return m_parent.size();
     }
 
+    /// The object at position `index`.
+    T operator[](size_t index)
+    {
+        return T::schema::create(m_parent.template get<Obj>(index), m_parent.get_realm());
+    }
+
     results& where(const std::string& query, std::vector<Mixed> arguments)
     {
-        m_parent = realm::Results(m_parent.get_realm(), m_parent.get_table()->query(query,
-                                                                                    std::move(arguments)));
+        if (m_query_cache) {
+            auto realm = m_parent.get_realm();
+            auto table = realm->read_group().get_table(m_parent.get_table()->get_key());
+            m_parent = realm::Results(realm, m_query_cache->get(table, query)->bind(std::move(arguments)));
+        } else {
+            m_parent = realm::Results(m_parent.get_realm(), m_parent.get_table()->query(query,
+                                                                                        std::move(arguments)));
+        }
         return *this;
     }
     results& where(std::function<rbool(T&)> fn)
@@ -131,14 +327,213 @@ struct results {
         m_parent = realm::Results(m_parent.get_realm(), full_query);
         return *this;
     }
+    template <typename Fn, typename ...Args>
+    results& where(compiled_query<T, Fn>& compiled, const Args&... arguments)
+    {
+        auto& object = compiled.object_for(m_parent.get_realm(), m_parent.get_table());
+        m_parent = realm::Results(m_parent.get_realm(), compiled.m_fn(object, arguments...).q);
+        return *this;
+    }
+
+    /// Registers a handler to be called each time the results change.
+    ///
+    /// The change set is computed incrementally by core's background notifier. The handler is
+    /// called once with an empty change when the results are first evaluated, then after each
+    /// commit which changes them. The results must outlive the returned token.
+    ///
+    /// The notifier is attached to these results, so reading them while observed uses the
+    /// snapshot computed in the background instead of re-running the query.
+    /// ```cpp
+    /// auto adults = realm.objects<Person>().where([](auto& person) { return person.age >= 18; });
+    /// auto token = adults.observe([](auto&& change, std::exception_ptr) {
+    ///     // update the rows at change.insertions, change.deletions, ...
+    /// });
+    /// ```
+    notification_token observe(util::UniqueFunction<void(ResultsChange<T>, std::exception_ptr)> handler)
+    {
+        notification_token token;
+        token.m_token = m_parent.add_notification_callback(ResultsCallbackWrapper<T> { std::move(handler), this });
+        return token;
+    }
+
+    /// Limits the results to at most `max_count` objects.
+    ///
+    /// The limit is applied by core as part of the descriptor ordering, after any
+    /// filters and sorts, so only the objects on the requested page are materialized.
+    results& limit(size_t max_count)
+    {
+        m_parent = m_parent.limit(max_count);
+        return *this;
+    }
+
+    /// Keyset pagination: restricts the results to objects whose primary key is greater
+    /// than `last_primary_key`, ordered by primary key.
+    ///
+    /// Combined with `limit`, this fetches the page following the last object of the
+    /// previous page without iterating over any of the preceding objects:
+    /// ```cpp
+    /// auto page = realm.objects<Person>().after(last_id).limit(100);
+    /// ```
+    template <typename S = T>
+    results& after(const typename S::schema::PrimaryKeyProperty::Result& last_primary_key)
+    requires (S::schema::HasPrimaryKeyProperty)
+    {
+        using PrimaryKey = typename S::schema::PrimaryKeyProperty::Result;
+        auto table = m_parent.get_table();
+        auto query = table->where().greater(table->get_primary_key_column(),
+                                            type_info::convert_if_required<PrimaryKey>(last_primary_key));
+        m_parent = m_parent.filter(std::move(query)).sort({{S::schema::PrimaryKeyProperty::name, true}});
+        return *this;
+    }
 private:
     template <type_info::ObjectPersistable...>
     friend struct db;
-    results(realm::Results&& parent)
+    template <type_info::ObjectPersistable>
+    friend struct prepared_query;
+    template <typename, StringLiteral>
+    friend struct linking_objects;
+#if QT_CORE_LIB
+    template <type_info::ObjectPersistable>
+    friend class qt::results_model;
+#endif
+    results(realm::Results&& parent, std::shared_ptr<query_cache> query_cache = nullptr)
     : m_parent(std::move(parent))
+    , m_query_cache(std::move(query_cache))
     {
     }
     realm::Results m_parent;
+    std::shared_ptr<query_cache> m_query_cache;
+};
+
+/// A query string parsed once against `T`'s table, which can be executed repeatedly
+/// with different arguments.
+///
+/// ```cpp
+/// auto by_age_and_name = realm.prepare<Person>("age > $0 AND name == $1");
+/// auto adults_named_john = by_age_and_name.execute({18, "John"});
+/// ```
+template <type_info::ObjectPersistable T>
+struct prepared_query {
+    results<T> execute(std::vector<Mixed> arguments)
+    {
+        return results<T>(realm::Results(m_realm, m_parsed->bind(std::move(arguments))));
+    }
+private:
+    template <type_info::ObjectPersistable...>
+    friend struct db;
+    prepared_query(SharedRealm realm, TableRef table, const std::string& query_string)
+    : m_realm(std::move(realm))
+    , m_parsed(std::make_shared<parsed_query>(std::move(table), query_string))
+    {
+    }
+    SharedRealm m_realm;
+    std::shared_ptr<parsed_query> m_parsed;
+};
+
+// MARK: linking_objects
+/// The objects of type `T` which link to the owning object through `T`'s property named `Name`.
+///
+/// Declared as a member of the link target and added to its schema like any other property.
+/// The origin type only needs to be declared, so a pair of types can link to each other:
+/// ```cpp
+/// struct Person;
+/// struct Dog: realm::object {
+///     realm::persisted<std::string> name;
+///     realm::linking_objects<Person, "dog"> owners;
+///
+///     using schema = realm::schema<"Dog",
+///                                  realm::property<"name", &Dog::name>,
+///                                  realm::property<"owners", &Dog::owners>>;
+/// };
+/// ```
+/// The linking objects are read from core's backlinks of the owning object, so lookups only
+/// touch the linking objects instead of scanning the origin table.
+/// Only managed objects have linking objects.
+template <typename T, StringLiteral Name>
+struct linking_objects {
+    using origin_type = T;
+    static constexpr const char* origin_property_name = Name.value;
+
+    /// The linking objects as `results`, which can be further filtered and sorted.
+    results<T> operator*() const
+    {
+        return linking();
+    }
+
+    size_t size() const
+    {
+        if (!m_obj) {
+            return 0;
+        }
+        auto [table, column_key] = origin();
+        return m_obj->get_backlink_count(*table, column_key);
+    }
+
+    typename results<T>::iterator begin()
+    {
+        return linking().begin();
+    }
+
+    typename results<T>::iterator end()
+    {
+        return linking().end();
+    }
+
+    /// The linking objects matching `query_string`.
+    results<T> where(const std::string& query_string, std::vector<Mixed> arguments) const
+    {
+        auto& parent = linking().m_parent;
+        return results<T>(parent.filter(parent.get_table()->query(query_string, std::move(arguments))));
+    }
+
+    /// The linking objects matching the query built by `fn`.
+    results<T> where(std::function<rbool(T&)> fn) const
+    {
+        auto& parent = linking().m_parent;
+        auto builder = Query(parent.get_table());
+        auto q = query<T>(builder, *m_realm->schema().find(T::schema::name));
+        return results<T>(parent.filter(fn(q).q));
+    }
+private:
+    template <StringLiteral, auto, bool, bool>
+    friend struct property;
+
+    void assign(const Obj& object, SharedRealm realm)
+    {
+        m_obj = object;
+        m_realm = std::move(realm);
+        m_results.reset();
+    }
+
+    // The results are only built when the linking objects are first read, so objects which
+    // never read them don't pay for the backlink view.
+    results<T>& linking() const
+    {
+        if (!m_results) {
+            if (!m_obj) {
+                throw std::runtime_error("Only managed objects have linking objects");
+            }
+            auto [table, column_key] = origin();
+            m_results.emplace(results<T>(realm::Results(m_realm, m_obj->get_backlink_view(table, column_key))));
+        }
+        return *m_results;
+    }
+
+    std::pair<TableRef, ColKey> origin() const
+    {
+        if (!m_realm) {
+            throw std::runtime_error("Linking objects can only be read from objects obtained through their Realm");
+        }
+        auto& object_schema = *m_realm->schema().find(T::schema::name);
+        return {m_realm->read_group().get_table(object_schema.table_key),
+                object_schema.property_for_name(origin_property_name)->column_key};
+    }
+
+    std::optional<Obj> m_obj;
+    SharedRealm m_realm;
+    // Built once per object, on first use. The backlink view re-syncs with the object whenever
+    // it is read, so the same results serve every iteration and iterators from begin() and end() agree.
+    mutable std::optional<results<T>> m_results;
 };
 
 }
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2022 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef realm_results_model_hpp
+#define realm_results_model_hpp
+
+#if QT_CORE_LIB
+
+#include <cpprealm/notifications.hpp>
+#include <cpprealm/results.hpp>
+#include <cpprealm/type_info.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QString>
+
+namespace realm::qt {
+
+/// A Qt list model over live `results<T>`.
+///
+/// Each property in `T`'s schema is exposed as a role named after the property, starting at
+/// `Qt::UserRole + 1` in schema order; `Qt::DisplayRole` returns the first property. Rows are
+/// only read when the view asks for them, one column per role, from the snapshot computed by
+/// the results' background notifier. Changes to the results are applied as row insertions,
+/// removals and `dataChanged` signals rather than a model reset.
+///
+/// The model must live on the thread which delivers the results' notifications, e.g.
+/// the Qt main thread.
+/// ```cpp
+/// auto model = new realm::qt::results_model<Person>(realm.objects<Person>());
+/// view->setModel(model);
+/// ```
+template <type_info::ObjectPersistable T>
+class results_model : public QAbstractListModel {
+public:
+    explicit results_model(results<T> results, QObject* parent = nullptr)
+    : QAbstractListModel(parent)
+    , m_results(std::move(results))
+    , m_count(static_cast<int>(m_results.size()))
+    {
+        auto table = m_results.m_parent.get_table();
+        size_t i = 0;
+        std::apply([&](auto&&... props) {
+            ((m_columns[i++] = table->get_column_key(props.name)), ...);
+        }, T::schema::properties);
+        // Observing attaches the notifier to `m_results`, so `data` reads the notifier's snapshot.
+        m_token = m_results.observe([this](ResultsChange<T> change, std::exception_ptr error) {
+            if (!error) {
+                apply(change);
+            }
+        });
+    }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_count;
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override
+    {
+        if (!index.isValid() || index.row() >= m_count) {
+            return {};
+        }
+        size_t property_index;
+        if (role == Qt::DisplayRole) {
+            property_index = 0;
+        } else if (role > Qt::UserRole && role <= Qt::UserRole + property_count) {
+            property_index = role - Qt::UserRole - 1;
+        } else {
+            return {};
+        }
+
+        auto object = m_results.m_parent.template get<Obj>(index.row());
+        auto column_key = m_columns[property_index];
+        QVariant value;
+        size_t i = 0;
+        std::apply([&](auto&&... props) {
+            ((i++ == property_index ? void(value = read_column(props, object, column_key)) : void()), ...);
+        }, T::schema::properties);
+        return value;
+    }
+
+    QHash<int, QByteArray> roleNames() const override
+    {
+        QHash<int, QByteArray> names;
+        int role = Qt::UserRole + 1;
+        std::apply([&](auto&&... props) {
+            ((names[role++] = QByteArray(props.name)), ...);
+        }, T::schema::properties);
+        return names;
+    }
+
+private:
+    static constexpr int property_count = static_cast<int>(std::tuple_size_v<std::remove_cv_t<decltype(T::schema::properties)>>);
+
+    // Whether the model shows values of type `V`. Links, lists and binary data have no
+    // natural QVariant representation.
+    template <typename V>
+    static constexpr bool is_displayable()
+    {
+        if constexpr (type_info::OptionalPersistable<V>) {
+            return is_displayable<typename V::value_type>();
+        } else {
+            return type_info::StringPersistable<V> || type_info::EnumPersistable<V>
+                   || type_info::TimestampPersistable<V> || type_info::UUIDPersistable<V>
+                   || type_info::IntPersistable<V> || type_info::BoolPersistable<V>
+                   || type_info::DoublePersistable<V>;
+        }
+    }
+
+    // Reads only the column of `Property`, rather than creating the whole object.
+    template <typename Property>
+    static QVariant read_column(const Property&, const Obj& object, ColKey column_key)
+    {
+        if constexpr (is_displayable<typename Property::Result>()) {
+            return to_variant(Property::read(object, column_key));
+        } else {
+            return {};
+        }
+    }
+
+    template <typename V>
+    static QVariant to_variant(const V& value)
+    {
+        if constexpr (type_info::OptionalPersistable<V>) {
+            return value ? to_variant(*value) : QVariant();
+        } else if constexpr (type_info::StringPersistable<V>) {
+            return QString::fromStdString(value);
+        } else if constexpr (type_info::EnumPersistable<V>) {
+            return QVariant::fromValue(static_cast<int64_t>(value));
+        } else if constexpr (type_info::TimestampPersistable<V>) {
+            return QDateTime::fromMSecsSinceEpoch(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(value.time_since_epoch()).count());
+        } else if constexpr (type_info::UUIDPersistable<V>) {
+            return QString::fromStdString(value.to_string());
+        } else {
+            return QVariant::fromValue(value);
+        }
+    }
+
+    // Calls `fn(first, last)` for each run of consecutive indices, in descending order when `reverse`.
+    template <typename Fn>
+    static void for_each_range(const std::vector<uint64_t>& indices, bool reverse, Fn&& fn)
+    {
+        auto emit_range = [&](size_t begin, size_t end) {
+            fn(static_cast<int>(indices[begin]), static_cast<int>(indices[end - 1]));
+        };
+        std::vector<std::pair<size_t, size_t>> ranges;
+        size_t begin = 0;
+        for (size_t i = 1; i <= indices.size(); i++) {
+            if (i == indices.size() || indices[i] != indices[i - 1] + 1) {
+                ranges.emplace_back(begin, i);
+                begin = i;
+            }
+        }
+        if (reverse) {
+            std::for_each(ranges.rbegin(), ranges.rend(), [&](auto& range) { emit_range(range.first, range.second); });
+        } else {
+            std::for_each(ranges.begin(), ranges.end(), [&](auto& range) { emit_range(range.first, range.second); });
+        }
+    }
+
+    void apply(const ResultsChange<T>& change)
+    {
+        // Moves are also reported as a deletion and an insertion, so applying deletions in
+        // descending order and then insertions in ascending order keeps the rows consistent.
+        for_each_range(change.deletions, true, [this](int first, int last) {
+            beginRemoveRows(QModelIndex(), first, last);
+            m_count -= last - first + 1;
+            endRemoveRows();
+        });
+        for_each_range(change.insertions, false, [this](int first, int last) {
+            beginInsertRows(QModelIndex(), first, last);
+            m_count += last - first + 1;
+            endInsertRows();
+        });
+        for_each_range(change.modifications, false, [this](int first, int last) {
+            Q_EMIT dataChanged(index(first), index(last));
+        });
+    }
+
+    mutable results<T> m_results;
+    std::array<ColKey, property_count> m_columns;
+    int m_count;
+    notification_token m_token;
+};
+
+}
+
+#endif
+#endif /* realm_results_model_hpp */
@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////////////////////
+//
+// Copyright 2022 Realm Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef realm_scheduler_hpp
+#define realm_scheduler_hpp
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <realm/object-store/util/scheduler.hpp>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+namespace realm::util {
+
+/// A `Scheduler` which delivers notifications on a user supplied executor, such as a
+/// thread pool, instead of a run loop.
+///
+/// Work submitted through the scheduler runs on a strand: tasks run one at a time and in
+/// order, but not on a fixed thread. A `db` opened with the scheduler is confined to its
+/// strand, so it must only be used from within `invoke`, or from the notification callbacks
+/// it delivers. The scheduler must be owned by a `std::shared_ptr`.
+/// Opening one `db` per strand spreads observers across the executor's threads,
+/// while each `db` still delivers its notifications in order.
+/// ```cpp
+/// auto scheduler = std::make_shared<realm::util::ExecutorScheduler>([&pool](auto&& task) {
+///     pool.post(std::move(task));
+/// });
+/// scheduler->invoke([scheduler] {
+///     auto realm = realm::open<Person>({.scheduler = scheduler});
+///     // ...
+/// });
+/// ```
+struct ExecutorScheduler : public Scheduler, public std::enable_shared_from_this<ExecutorScheduler> {
+    /// Submits a task to the executor. It may run on any thread.
+    using executor = std::function<void(std::function<void()>)>;
+
+    explicit ExecutorScheduler(executor executor)
+    : m_executor(std::move(executor))
+    {
+    }
+
+    bool is_on_thread() const noexcept override
+    {
+        return t_current == this;
+    }
+    bool is_same_as(const Scheduler* other) const noexcept override
+    {
+        return other == this;
+    }
+    bool can_deliver_notifications() const noexcept override
+    {
+        return true;
+    }
+
+    void set_notify_callback(std::function<void()> fn) override
+    {
+        std::lock_guard lock(m_mutex);
+        m_callback = std::move(fn);
+    }
+
+    void notify() override
+    {
+        // Several notifies before the callback runs only need to deliver once.
+        if (m_notify_pending.exchange(true)) {
+            return;
+        }
+        invoke([this] {
+            m_notify_pending = false;
+            std::function<void()> callback;
+            {
+                std::lock_guard lock(m_mutex);
+                callback = m_callback;
+            }
+            if (callback) {
+                callback();
+            }
+        });
+    }
+
+    /// Runs `fn` on the strand, after any previously submitted work.
+    void invoke(std::function<void()> fn)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.push_back(std::move(fn));
+            if (m_draining) {
+                return;
+            }
+            m_draining = true;
+        }
+        m_executor([self = shared_from_this()] { self->drain(); });
+    }
+private:
+    void drain()
+    {
+        // Restores the previous scheduler when done, so that a strand drained from inside
+        // another strand's task does not clear the outer one, even if a task throws.
+        struct current_guard {
+            const ExecutorScheduler* previous;
+            ~current_guard() { t_current = previous; }
+        } guard{std::exchange(t_current, this)};
+        while (true) {
+            std::function<void()> task;
+            {
+                std::lock_guard lock(m_mutex);
+                if (m_tasks.empty()) {
+                    m_draining = false;
+                    break;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    executor m_executor;
+    std::mutex m_mutex;
+    std::function<void()> m_callback;
+    std::deque<std::function<void()>> m_tasks;
+    bool m_draining = false;
+    std::atomic<bool> m_notify_pending = false;
+    static inline thread_local const ExecutorScheduler* t_current = nullptr;
+};
+
+#ifdef __linux__
+/// A `Scheduler` driven by an epoll loop, for headless Linux processes without a run loop.
+///
+/// The loop belongs to the thread which created the scheduler. Either let it block in `run()`
+/// until `stop()` is called, or nest it in an existing event loop: `fd()` becomes readable
+/// whenever work is pending, at which point `run_once()` processes it without blocking.
+///
+/// Wakeups go through an eventfd. With a non-zero `coalesce_interval`, notifications are
+/// delayed by a timerfd so that commits arriving within the interval are delivered together.
+/// ```cpp
+/// auto scheduler = std::make_shared<realm::util::EpollScheduler>();
+/// auto realm = realm::open<Person>({.scheduler = scheduler});
+/// auto token = realm.objects<Person>().observe(...);
+/// scheduler->run();
+/// ```
+struct EpollScheduler : public Scheduler {
+    explicit EpollScheduler(std::chrono::microseconds coalesce_interval = {})
+    : m_coalesce_interval(coalesce_interval)
+    {
+        m_epoll_fd = check(epoll_create1(EPOLL_CLOEXEC), "epoll_create1");
+        m_event_fd = check(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK), "eventfd");
+        m_timer_fd = check(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK), "timerfd_create");
+        for (int fd : {m_event_fd, m_timer_fd}) {
+            epoll_event event = { .events = EPOLLIN, .data = { .fd = fd } };
+            check(epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event), "epoll_ctl");
+        }
+    }
+
+    ~EpollScheduler()
+    {
+        for (int fd : {m_timer_fd, m_event_fd, m_epoll_fd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    EpollScheduler(const EpollScheduler&) = delete;
+    EpollScheduler& operator=(const EpollScheduler&) = delete;
+
+    bool is_on_thread() const noexcept override
+    {
+        return m_thread == std::this_thread::get_id();
+    }
+    bool is_same_as(const Scheduler* other) const noexcept override
+    {
+        return other == this;
+    }
+    bool can_deliver_notifications() const noexcept override
+    {
+        return true;
+    }
+
+    void set_notify_callback(std::function<void()> fn) override
+    {
+        std::lock_guard lock(m_mutex);
+        m_callback = std::move(fn);
+    }
+
+    void notify() override
+    {
+        if (m_notify_pending.exchange(true)) {
+            return;
+        }
+        if (m_coalesce_interval.count() == 0) {
+            wake();
+            return;
+        }
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(m_coalesce_interval);
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(m_coalesce_interval - seconds);
+        itimerspec timer = {
+            .it_interval = {},
+            .it_value = { .tv_sec = static_cast<time_t>(seconds.count()), .tv_nsec = static_cast<long>(nanoseconds.count()) }
+        };
+        check(timerfd_settime(m_timer_fd, 0, &timer, nullptr), "timerfd_settime");
+    }
+
+    /// Runs `fn` on the loop's thread, the next time the loop runs.
+    void invoke(std::function<void()> fn)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_tasks.push_back(std::move(fn));
+        }
+        wake();
+    }
+
+    /// Processes events until `stop()` is called. Returns immediately if `stop()` was called
+    /// before, so a stop racing with the start of the loop is not lost.
+    void run()
+    {
+        while (!m_stopped) {
+            run_once(-1);
+        }
+        m_stopped = false;
+    }
+
+    /// Waits up to `timeout_ms` milliseconds for events, or indefinitely if it is negative, and
+    /// processes those which are ready. Returns whether any work was done.
+    bool run_once(int timeout_ms = 0)
+    {
+        epoll_event events[2];
+        int count = epoll_wait(m_epoll_fd, events, 2, timeout_ms);
+        if (count < 0) {
+            if (errno == EINTR) {
+                return false;
+            }
+            throw std::system_error(errno, std::generic_category(), "epoll_wait");
+        }
+        bool did_work = false;
+        bool timer_fired = false;
+        for (int i = 0; i < count; i++) {
+            uint64_t value;
+            // Reading resets the eventfd counter and the timer's expiration count.
+            while (::read(events[i].data.fd, &value, sizeof(value)) > 0) {
+            }
+            timer_fired |= events[i].data.fd == m_timer_fd;
+        }
+        if (count > 0) {
+            // Pending notifications wait for the timer, so that a wakeup for `invoke` or `stop`
+            // does not cut the coalescing interval short.
+            if (timer_fired || m_coalesce_interval.count() == 0) {
+                did_work |= deliver();
+            }
+            did_work |= drain();
+        }
+        return did_work;
+    }
+
+    /// Makes `run()` return once the current iteration is done. Can be called from any thread.
+    void stop()
+    {
+        m_stopped = true;
+        wake();
+    }
+
+    /// The epoll descriptor of the loop, which is readable while work is pending.
+    int fd() const noexcept
+    {
+        return m_epoll_fd;
+    }
+private:
+    static int check(int result, const char* operation)
+    {
+        if (result < 0) {
+            throw std::system_error(errno, std::generic_category(), operation);
+        }
+        return result;
+    }
+
+    void wake()
+    {
+        uint64_t one = 1;
+        // EAGAIN means the counter is saturated, so the loop is already due to wake up.
+        if (::write(m_event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+    }
+
+    bool deliver()
+    {
+        if (!m_notify_pending.exchange(false)) {
+            return false;
+        }
+        std::function<void()> callback;
+        {
+            std::lock_guard lock(m_mutex);
+            callback = m_callback;
+        }
+        if (callback) {
+            callback();
+        }
+        return true;
+    }
+
+    bool drain()
+    {
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard lock(m_mutex);
+            tasks.swap(m_tasks);
+        }
+        for (auto& task : tasks) {
+            task();
+        }
+        return !tasks.empty();
+    }
+
+    std::chrono::microseconds m_coalesce_interval;
+    int m_epoll_fd = -1;
+    int m_event_fd = -1;
+    int m_timer_fd = -1;
+    std::thread::id m_thread = std::this_thread::get_id();
+    std::mutex m_mutex;
+    std::function<void()> m_callback;
+    std::deque<std::function<void()>> m_tasks;
+    std::atomic<bool> m_notify_pending = false;
+    std::atomic<bool> m_stopped = false;
+};
+#endif
+
+}
+
+#endif /* realm_scheduler_hpp */
@@ -24,6 +24,8 @@
 #include <realm/object-store/object_schema.hpp>
 #include <realm/object-store/shared_realm.hpp>
 
+#include <span>
+
 namespace realm {
 
 namespace {
@@ -44,11 +46,19 @@ struct ptr_type_extractor : ptr_type_extractor_base<decltype(T)> {
 
 // MARK: property
 using IsPrimaryKey = bool;
-template <StringLiteral Name, auto Ptr, IsPrimaryKey IsPrimaryKey = false>
+/// Declares a persisted property in a `realm::schema`.
+///
+/// Passing `true` for `Indexed` adds a search index to the column, which turns equality
+/// queries on it into index lookups instead of table scans. Indexes can be added to or
+/// removed from an existing file by changing the flag; the change is applied when the file is opened.
+template <StringLiteral Name, auto Ptr, IsPrimaryKey IsPrimaryKey = false, bool Indexed = false>
 struct property {
     using Result = typename ptr_type_extractor<Ptr>::member_type::Result;
     using Class = typename ptr_type_extractor<Ptr>::class_type;
 
+    static_assert(!Indexed || type_info::Indexable<Result>,
+                  "Only int, bool, string, date and uuid properties can be indexed.");
+
     constexpr property()
     : type(type_info::property_type<Result>())
     {
@@ -63,7 +73,7 @@ struct property {
             if constexpr (type_info::ObjectPersistable<typename Result::value_type>) {
                 return realm::Property(name, type, Result::value_type::schema::name);
             } else {
-                return realm::Property(name, type);
+                return realm::Property(name, type, is_primary_key, is_indexed);
             }
         } else if constexpr (type_info::ListPersistable<Result>) {
             if constexpr (type_info::ObjectPersistable<typename Result::value_type>) {
@@ -71,19 +81,33 @@ struct property {
             } else {
                 return realm::Property(name, type, is_primary_key);
             }
-        } else {
+        } else if constexpr (type_info::SetPersistable<Result> || type_info::DictionaryPersistable<Result>) {
             return realm::Property(name, type, is_primary_key);
+        } else {
+            return realm::Property(name, type, is_primary_key, is_indexed);
         }
     }
 
     static void assign(Class& object, ColKey col_key, SharedRealm realm) {
-        if constexpr (type_info::ListPersistable<Result>) {
+        if constexpr (type_info::ListPersistable<Result> || type_info::SetPersistable<Result>
+                      || type_info::DictionaryPersistable<Result>) {
+            (object.*Ptr).assign(*object.m_obj, col_key, realm);
+        } else if constexpr (type_info::OptionalObjectPersistable<Result> || type_info::BinaryPersistable<Result>) {
             (object.*Ptr).assign(*object.m_obj, col_key, realm);
         } else {
             (object.*Ptr).assign(*object.m_obj, col_key);
         }
     }
 
+    /// Reads the value of this property from `object`, without creating the rest of `Class`.
+    static Result read(const Obj& object, ColKey col_key)
+    requires (!type_info::ListPersistable<Result> && !type_info::SetPersistable<Result>
+              && !type_info::DictionaryPersistable<Result>) {
+        persisted<Result> field;
+        field.assign(object, col_key);
+        return *field;
+    }
+
     static void set(Class& object, ColKey col_key) {
         object.m_obj->template set<typename type_info::persisted_type<Result>::type>(col_key,
                                                                                      (object.*ptr).as_core_type());
@@ -99,6 +123,19 @@ struct property {
             object.m_obj->set_list_values(col_key, (object.*ptr).as_core_type());
         }
     }
+    static void set(Class& object, ColKey col_key) requires (type_info::SetPersistable<Result>) {
+        using core_type = typename type_info::persisted_type<typename Result::value_type>::type;
+        auto set = object.m_obj->template get_set<core_type>(col_key);
+        for (auto& value : (object.*ptr).unmanaged) {
+            set.insert(type_info::convert_if_required<typename Result::value_type>(value));
+        }
+    }
+    static void set(Class& object, ColKey col_key) requires (type_info::DictionaryPersistable<Result>) {
+        auto dictionary = object.m_obj->get_dictionary(col_key);
+        for (auto& [key, value] : (object.*ptr).unmanaged) {
+            dictionary.insert(StringData(key), Mixed(type_info::convert_if_required<typename Result::mapped_type>(value)));
+        }
+    }
     static void set(Class& object, ColKey col_key) requires (type_info::OptionalObjectPersistable<Result>) {
         auto field = (object.*ptr);
         if (*field) {
@@ -124,14 +161,59 @@ struct property {
     static constexpr persisted<Result> Class::*ptr = Ptr;
     PropertyType type;
     static constexpr bool is_primary_key = IsPrimaryKey;
+    static constexpr bool is_indexed = Indexed;
+    static constexpr bool is_computed = false;
+};
+
+/// A `realm::linking_objects` member. It has no column of its own; its contents are
+/// computed from the backlinks of the origin property.
+template <StringLiteral Name, auto Ptr, IsPrimaryKey IsPrimaryKey, bool Indexed>
+requires (type_info::LinkingObjectsPersistable<typename ptr_type_extractor<Ptr>::member_type>)
+struct property<Name, Ptr, IsPrimaryKey, Indexed> {
+    using Result = typename ptr_type_extractor<Ptr>::member_type;
+    using Class = typename ptr_type_extractor<Ptr>::class_type;
+
+    static_assert(!IsPrimaryKey && !Indexed, "Linking objects cannot be a primary key or indexed.");
+
+    constexpr property()
+    : type(PropertyType::LinkingObjects | PropertyType::Array)
+    {
+    }
+
+    explicit operator realm::Property() const {
+        return realm::Property(name, type, Result::origin_type::schema::name, Result::origin_property_name);
+    }
+
+    static void assign(Class& object, ColKey, SharedRealm realm) {
+        (object.*Ptr).assign(*object.m_obj, realm);
+    }
+
+    static void set(Class&, ColKey) {
+    }
+
+    static constexpr const char* name = Name.value;
+    static constexpr Result Class::*ptr = Ptr;
+    PropertyType type;
+    static constexpr bool is_primary_key = false;
+    static constexpr bool is_indexed = false;
+    static constexpr bool is_computed = true;
 };
 
+/// A `realm::property` with a search index on its column.
+template <StringLiteral Name, auto Ptr>
+using indexed_property = property<Name, Ptr, false, true>;
+
 // MARK: schema
 template <StringLiteral Name, type_info::Propertyable ...Properties>
 struct schema {
     using Class = typename std::tuple_element_t<0, std::tuple<Properties...>>::Class;
     static constexpr const char* name = Name.value;
-    static constexpr const std::tuple<Properties...> properties{};
+    /// The persisted properties of the schema, in declaration order.
+    static constexpr auto properties = std::tuple_cat(
+            std::conditional_t<Properties::is_computed, std::tuple<>, std::tuple<Properties>>{}...);
+    /// The computed properties of the schema, such as `realm::linking_objects`.
+    static constexpr auto computed_properties = std::tuple_cat(
+            std::conditional_t<Properties::is_computed, std::tuple<Properties>, std::tuple<>>{}...);
 
     template <size_t N, type_info::Propertyable P>
     static constexpr auto primary_key(P&)
@@ -139,7 +221,7 @@ struct schema {
         if constexpr (P::is_primary_key) {
             return P();
         } else {
-            if constexpr (N + 1 == sizeof...(Properties)) {
+            if constexpr (N + 1 == std::tuple_size_v<decltype(properties)>) {
                 return;
             } else {
                 return primary_key<N + 1>(std::get<N + 1>(properties));
@@ -157,7 +239,8 @@ struct schema {
     {
         realm::ObjectSchema schema;
         schema.name = Name;
-        (schema.persisted_properties.push_back(static_cast<realm::Property>(Properties())) , ...);
+        ((Properties::is_computed ? schema.computed_properties : schema.persisted_properties)
+                .push_back(static_cast<realm::Property>(Properties())) , ...);
         if constexpr (HasPrimaryKeyProperty) {
             schema.primary_key = PrimaryKeyProperty::name;
         }
@@ -209,6 +292,26 @@ struct schema {
         set(object);
         initialize(object, std::move(managed), realm);
     }
+
+    /// Adds several unmanaged objects to `table`. Objects without a primary key have
+    /// their keys allocated by core in a single call.
+    static void add(std::span<Class* const> objects, TableRef table, SharedRealm realm)
+    {
+        if constexpr (HasPrimaryKeyProperty) {
+            for (auto object : objects) {
+                add(*object, table, realm);
+            }
+        } else {
+            std::vector<ObjKey> keys;
+            table->create_objects(objects.size(), keys);
+            for (size_t i = 0; i < objects.size(); i++) {
+                auto managed = table->get_object(keys[i]);
+                objects[i]->m_obj = managed;
+                set(*objects[i]);
+                initialize(*objects[i], std::move(managed), realm);
+            }
+        }
+    }
 };
 
 }
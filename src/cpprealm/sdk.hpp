@@ -25,6 +25,8 @@
 #include <cpprealm/persisted.hpp>
 #include <cpprealm/schema.hpp>
 #include <cpprealm/results.hpp>
+#include <cpprealm/results_model.hpp>
+#include <cpprealm/scheduler.hpp>
 #include <cpprealm/notifications.hpp>
 #include <cpprealm/object.hpp>
 #include <cpprealm/app.hpp>
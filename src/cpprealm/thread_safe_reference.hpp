@@ -22,6 +22,7 @@
 #include <cpprealm/type_info.hpp>
 #include <realm/object-store/thread_safe_reference.hpp>
 #include <realm/object-store/shared_realm.hpp>
+#include <realm/object-store/util/scheduler.hpp>
 
 namespace realm {
 
@@ -49,8 +50,9 @@ struct db;
 
 template <type_info::ObjectPersistable ...Ts>
 struct thread_safe_reference<db<Ts...>> {
-    thread_safe_reference(ThreadSafeReference tsr)
+    thread_safe_reference(ThreadSafeReference tsr, std::shared_ptr<util::Scheduler> scheduler = nullptr)
     : m_tsr(std::move(tsr))
+    , m_scheduler(std::move(scheduler))
     {
     }
     thread_safe_reference() = default;
@@ -62,10 +64,12 @@ struct thread_safe_reference<db<Ts...>> {
 
     db<Ts...> resolve()
     {
-        return db<Ts...>(Realm::get_shared_realm(std::move(m_tsr)));
+        return db<Ts...>(Realm::get_shared_realm(std::move(m_tsr), m_scheduler));
     }
 private:
     ThreadSafeReference m_tsr;
+    // The scheduler of the resolved `db`, or the default one if unset.
+    std::shared_ptr<util::Scheduler> m_scheduler;
     template <type_info::ObjectPersistable ...>
     friend struct db;
 };
@@ -19,8 +19,10 @@
 #ifndef realm_type_info_hpp
 #define realm_type_info_hpp
 
+#include <map>
 #include <optional>
 #include <concepts>
+#include <set>
 
 #include <realm/object-store/property.hpp>
 #include <realm/obj.hpp>
@@ -152,6 +154,20 @@ concept ListPersistable = !std::is_same_v<typename T::value_type, std::uint8_t>
 template <ListPersistable T>
 struct persisted_type<T> { using type = std::vector<typename persisted_type<typename T::value_type>::type>; };
 
+// MARK: SetPersistable
+template <typename T>
+concept SetPersistable = PrimitivePersistable<typename T::value_type>
+    && std::is_same_v<std::set<typename T::value_type>, T>;
+template <SetPersistable T>
+struct persisted_type<T> { using type = std::set<typename persisted_type<typename T::value_type>::type>; };
+
+// MARK: DictionaryPersistable
+template <typename T>
+concept DictionaryPersistable = PrimitivePersistable<typename T::mapped_type>
+    && std::is_same_v<std::map<std::string, typename T::mapped_type>, T>;
+template <DictionaryPersistable T>
+struct persisted_type<T> { using type = std::map<std::string, typename persisted_type<typename T::mapped_type>::type>; };
+
 template <typename T>
 concept OptionalObjectPersistable = Optional<T> && ObjectPersistable<typename T::value_type>;
 template <typename T>
@@ -163,7 +179,22 @@ struct persisted_type<std::optional<T>> { using type = realm::ObjKey; };
 template <typename T>
 concept NonContainerPersistable = NonOptionalPersistable<T> || OptionalPersistable<T>;
 template <typename T>
-concept Persistable = NonOptionalPersistable<T> || OptionalPersistable<T> || ListPersistable<T>;
+concept IndexablePrimitive = IntPersistable<T>
+        || BoolPersistable<T>
+        || StringPersistable<T>
+        || EnumPersistable<T>
+        || TimestampPersistable<T>
+        || UUIDPersistable<T>;
+template <typename T>
+concept Indexable = IndexablePrimitive<T> || (OptionalPersistable<T> && IndexablePrimitive<typename T::value_type>);
+template <typename T>
+concept Persistable = NonOptionalPersistable<T> || OptionalPersistable<T> || ListPersistable<T>
+        || SetPersistable<T> || DictionaryPersistable<T>;
+template <typename T>
+concept LinkingObjectsPersistable = requires {
+    typename T::origin_type;
+    { T::origin_property_name } -> std::convertible_to<const char*>;
+};
 
 template <PrimitivePersistable T>
 constexpr typename persisted_type<T>::type convert_if_required(const T& a)
@@ -232,6 +263,12 @@ template<ListPersistable T> static constexpr PropertyType property_type()
 requires (ObjectPersistable<typename T::value_type>) {
     return PropertyType::Array | PropertyType::Object;
 }
+template<SetPersistable T> static constexpr PropertyType property_type() {
+    return PropertyType::Set | property_type<typename T::value_type>();
+}
+template<DictionaryPersistable T> static constexpr PropertyType property_type() {
+    return PropertyType::Dictionary | property_type<typename T::mapped_type>();
+}
 template <typename T>
 concept Propertyable = requires(T a) {
     { std::is_same_v<std::string, decltype(a.name)> };
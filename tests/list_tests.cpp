@@ -2,6 +2,9 @@
 #include "test_objects.hpp"
 #include <cpprealm/notifications.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace realm;
 
 TEST(list) {
@@ -13,7 +16,7 @@ TEST(list) {
     obj.list_obj_col.push_back(AllTypesObjectLink{.str_col="Fido"});
     CHECK_EQUALS(obj.list_obj_col[0].str_col, "Fido");
     CHECK_EQUALS(obj.list_int_col.size(), 1);
-    for (auto& i : obj.list_int_col) {
+    for (auto&& i : obj.list_int_col) {
         CHECK_EQUALS(i, 42);
     }
     realm.write([&realm, &obj]() {
@@ -28,7 +31,7 @@ TEST(list) {
         obj.list_obj_col.push_back(AllTypesObjectLink{._id=1, .str_col="Rex"});
     });
     size_t idx = 0;
-    for (auto& i : obj.list_int_col) {
+    for (auto&& i : obj.list_int_col) {
         CHECK_EQUALS(i, obj.list_int_col[idx]);
         ++idx;
     }
@@ -178,6 +181,161 @@ TEST(list_insert_remove_object) {
     co_return;
 }
 
+TEST(list_bulk_operations) {
+    auto obj = AllTypesObject();
+    obj.list_int_col.append_range(std::vector<int>{1, 2, 3});
+    obj.list_int_col.insert(1, std::vector<int>{4, 5});
+    CHECK_EQUALS(obj.list_int_col.size(), 5);
+    CHECK_EQUALS(obj.list_int_col[1], 4);
+
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+
+    realm.write([&obj] {
+        obj.list_int_col.append_range(std::views::iota(10, 20));
+        obj.list_int_col.insert(0, std::vector<int>{7, 8});
+    });
+    CHECK_EQUALS(obj.list_int_col.size(), 17);
+    CHECK_EQUALS(obj.list_int_col[0], 7);
+    CHECK_EQUALS(obj.list_int_col[3], 4);
+    CHECK_EQUALS(obj.list_int_col[16], 19);
+
+    realm.write([&obj] {
+        obj.list_int_col.resize(3);
+        obj.list_str_col.assign(std::vector<std::string>{"a", "b"});
+        obj.list_str_col.resize(3);
+    });
+    CHECK_EQUALS(obj.list_int_col.size(), 3);
+    CHECK_EQUALS(obj.list_str_col.size(), 3);
+    CHECK_EQUALS(obj.list_str_col[1], "b");
+    CHECK_EQUALS(obj.list_str_col[2], "");
+    // A view of the list itself is read before the list is cleared.
+    realm.write([&obj] {
+        obj.list_str_col.assign(obj.list_str_col.view());
+    });
+    CHECK_EQUALS(obj.list_str_col.size(), 3);
+    CHECK_EQUALS(obj.list_str_col[1], "b");
+
+    std::vector<AllTypesObjectLink> links;
+    for (int i = 0; i < 3; i++) {
+        links.push_back(AllTypesObjectLink{._id = i, .str_col = "link"});
+    }
+    realm.write([&obj, &links] {
+        obj.list_obj_col.append_range(links);
+        obj.list_obj_col.insert(0, std::span(links).subspan(2));
+    });
+    CHECK_EQUALS(links[0].is_managed(), true);
+    CHECK_EQUALS(obj.list_obj_col.size(), 4);
+    CHECK_EQUALS(obj.list_obj_col[0], links[2]);
+    CHECK_EQUALS(obj.list_obj_col[3], links[2]);
+    // Growing would add several objects with the same default primary key.
+    CHECK_THROWS([&obj] { obj.list_obj_col.resize(5); });
+    co_return;
+}
+
+TEST(list_iterator) {
+    static_assert(std::random_access_iterator<persisted<std::vector<int>>::iterator>);
+    static_assert(std::random_access_iterator<persisted<std::vector<AllTypesObjectLink>>::iterator>);
+    static_assert(std::ranges::random_access_range<persisted<std::vector<std::string>>>);
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    auto obj = AllTypesObject();
+    obj.list_str_col.append_range(std::vector<std::string>{"a", "bb", "ccc"});
+    CHECK_EQUALS(obj.list_str_col.end() - obj.list_str_col.begin(), 3);
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+        obj.list_int_col.append_range(std::views::iota(0, 100));
+    });
+
+    auto begin = obj.list_int_col.begin();
+    auto end = obj.list_int_col.end();
+    CHECK_EQUALS(end - begin, 100);
+    CHECK_EQUALS(begin[42], 42);
+    CHECK_EQUALS(*(end - 1), 99);
+    CHECK_EQUALS(*std::find(begin, end, 57), 57);
+    CHECK(begin < end);
+    CHECK_EQUALS(std::accumulate(begin, end, 0), 4950);
+    CHECK_EQUALS(*std::ranges::lower_bound(obj.list_int_col, 64), 64);
+    CHECK(std::ranges::binary_search(obj.list_int_col, 99));
+    CHECK_EQUALS(*std::ranges::max_element(obj.list_int_col), 99);
+
+    std::vector<std::string> strings;
+    for (auto&& str : obj.list_str_col) {
+        strings.push_back(str);
+    }
+    CHECK_EQUALS(strings[2], "ccc");
+    CHECK_EQUALS(obj.list_str_col.begin()->size(), 1);
+
+    realm.write([&obj] {
+        obj.list_obj_col.push_back(AllTypesObjectLink{._id=1, .str_col="Fido"});
+        obj.list_obj_col.push_back(AllTypesObjectLink{._id=2, .str_col="Rex"});
+    });
+    std::vector<std::string> names;
+    for (auto&& link : obj.list_obj_col) {
+        names.push_back(*link.str_col);
+    }
+    CHECK_EQUALS(names.size(), 2);
+    CHECK_EQUALS(names[1], "Rex");
+    CHECK_EQUALS(*obj.list_obj_col.begin()->str_col, "Fido");
+    CHECK_EQUALS(*(obj.list_obj_col.end() - 1), obj.list_obj_col[1]);
+    co_return;
+}
+
+TEST(list_view) {
+    static_assert(std::ranges::random_access_range<list_view<int>>);
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    auto obj = AllTypesObject();
+    obj.list_int_col.append_range(std::vector<int>{1, 2});
+    CHECK_EQUALS(obj.list_int_col.view().size(), 2);
+    CHECK_EQUALS(obj.list_int_col.view()[1], 2);
+
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+        obj.list_int_col.append_range(std::views::iota(3, 11));
+        obj.list_str_col.append_range(std::vector<std::string>{"foo", "bar"});
+    });
+    auto ints = obj.list_int_col.view();
+    CHECK_EQUALS(ints.size(), 10);
+    CHECK_EQUALS(ints.front(), 1);
+    CHECK_EQUALS(ints.back(), 10);
+    CHECK_EQUALS(std::accumulate(ints.begin(), ints.end(), 0), 55);
+    CHECK_EQUALS(std::ranges::count_if(ints, [](int i) { return i % 2 == 0; }), 5);
+
+    auto strings = obj.list_str_col.view();
+    CHECK_EQUALS(strings[1], "bar");
+    auto copy = *obj.list_int_col;
+    CHECK(std::ranges::equal(copy, ints));
+    co_return;
+}
+
+TEST(list_accessor_across_transactions) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    auto obj = AllTypesObject();
+    obj.list_int_col.push_back(1);
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+    CHECK_EQUALS(obj.list_int_col.size(), 1);
+
+    // writes through another accessor are visible through the cached one
+    auto other = realm.objects<AllTypesObject>()[0];
+    realm.write([&other] {
+        other.list_int_col.push_back(2);
+        other.list_int_col.push_back(3);
+    });
+    CHECK_EQUALS(obj.list_int_col.size(), 3);
+    CHECK_EQUALS(obj.list_int_col[2], 3);
+
+    realm.write([&obj] {
+        obj.list_int_col.erase(0);
+    });
+    CHECK_EQUALS(other.list_int_col.size(), 2);
+    CHECK_EQUALS(other.list_int_col[0], 2);
+    CHECK_EQUALS(obj.list_int_col.find(3), 1);
+    co_return;
+}
+
 TEST(notifications_insertions) {
     auto obj = AllTypesObject();
 
@@ -358,3 +516,122 @@ TEST(list_all_primitive_types) {
     test_list(date_list_obj.list_date_col, std::vector<std::chrono::time_point<std::chrono::system_clock>>({date1, date2}), realm, date_list_obj);
     co_return;
 }
+
+TEST(set) {
+    auto obj = AllTypesObject();
+    CHECK(obj.set_str_col.insert("a"));
+    CHECK(!obj.set_str_col.insert("a"));
+    obj.set_str_col.insert("b");
+    CHECK_EQUALS(obj.set_str_col.size(), 2);
+
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+    CHECK_EQUALS(obj.set_str_col.size(), 2);
+    CHECK(obj.set_str_col.contains("b"));
+
+    CollectionChange<std::set<std::string>> change;
+    auto token = obj.set_str_col.observe([&change](auto c, std::exception_ptr) {
+        change = std::move(c);
+    });
+    realm.write([&obj] {
+        CHECK(obj.set_str_col.insert("c"));
+        CHECK(!obj.set_str_col.insert("c"));
+        CHECK(obj.set_str_col.erase("a"));
+        CHECK(!obj.set_str_col.erase("a"));
+    });
+    realm.write([] { });
+    CHECK_EQUALS(change.insertions.size(), 1);
+    CHECK_EQUALS(change.deletions.size(), 1);
+    CHECK(!obj.set_str_col.contains("a"));
+    CHECK((*obj.set_str_col == std::set<std::string>{"b", "c"}));
+
+    auto results = realm.objects<AllTypesObject>().where([](auto& o) {
+        return o.set_str_col.contains("c");
+    });
+    CHECK_EQUALS(results.size(), 1);
+    auto no_results = realm.objects<AllTypesObject>().where([](auto& o) {
+        return o.set_str_col.contains("a");
+    });
+    CHECK_EQUALS(no_results.size(), 0);
+    co_return;
+}
+
+TEST(dictionary) {
+    auto obj = AllTypesObject();
+    obj.map_int_col.insert_or_assign("one", 1);
+    CHECK_EQUALS(*obj.map_int_col.find("one"), 1);
+
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+    CHECK_EQUALS(obj.map_int_col.size(), 1);
+    CHECK_EQUALS(*obj.map_int_col.find("one"), 1);
+    CHECK(!obj.map_int_col.find("two"));
+
+    DictionaryChange<std::map<std::string, int>> change;
+    auto token = obj.map_int_col.observe([&change](auto c, std::exception_ptr) {
+        change = std::move(c);
+    });
+    realm.write([&obj] {
+        obj.map_int_col.insert_or_assign("one", 11);
+        obj.map_int_col.insert_or_assign("two", 2);
+    });
+    realm.write([] { });
+    CHECK_EQUALS(change.insertions.size(), 1);
+    CHECK_EQUALS(change.insertions[0], "two");
+    CHECK_EQUALS(change.modifications[0], "one");
+    CHECK(obj.map_int_col.contains_key("two"));
+    CHECK(obj.map_int_col.contains_value(11));
+    CHECK_EQUALS((*obj.map_int_col)["two"], 2);
+
+    auto results = realm.objects<AllTypesObject>().where([](auto& o) {
+        return o.map_int_col.contains_key("two") && o.map_int_col.contains_value(11);
+    });
+    CHECK_EQUALS(results.size(), 1);
+
+    realm.write([&obj] {
+        CHECK(obj.map_int_col.erase("one"));
+        CHECK(!obj.map_int_col.erase("one"));
+    });
+    CHECK_EQUALS(obj.map_int_col.size(), 1);
+    co_return;
+}
+
+TEST(list_move_swap) {
+    auto obj = AllTypesObject();
+    obj.list_int_col.append_range(std::vector<int>{0, 1, 2, 3});
+    obj.list_int_col.move(0, 2);
+    CHECK_EQUALS(obj.list_int_col[2], 0);
+    obj.list_int_col.move(2, 0);
+    CHECK_EQUALS(obj.list_int_col[0], 0);
+    CHECK_EQUALS(obj.list_int_col[2], 2);
+
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+
+    CollectionChange<std::vector<int>> change;
+    auto token = obj.list_int_col.observe([&change](auto c, std::exception_ptr) {
+        change = std::move(c);
+    });
+    realm.write([&obj] {
+        obj.list_int_col.move(3, 1);
+    });
+    realm.write([] { });
+    CHECK_EQUALS(obj.list_int_col[1], 3);
+    CHECK_EQUALS(obj.list_int_col[3], 2);
+    CHECK_EQUALS(change.moves.size(), 1);
+    CHECK_EQUALS(change.moves[0].from, 3);
+    CHECK_EQUALS(change.moves[0].to, 1);
+
+    realm.write([&obj] {
+        obj.list_int_col.swap(0, 3);
+    });
+    CHECK_EQUALS(obj.list_int_col[0], 2);
+    CHECK_EQUALS(obj.list_int_col[3], 0);
+    co_return;
+}
@@ -164,3 +164,92 @@ TEST(tsq_compound) {
 
     co_return;
 }
+
+TEST(tsq_compiled) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    realm.write([&realm] {
+        realm.add(Person { .name = "John", .age = 42 });
+        realm.add(Person { .name = "Jane", .age = 17 });
+    });
+
+    auto older_than = realm::compile_query<Person>([](auto& person, auto& age) {
+        return person.age > age;
+    });
+    CHECK_EQUALS(realm.objects<Person>().where(older_than, 10).size(), 2);
+    CHECK_EQUALS(realm.objects<Person>().where(older_than, 18).size(), 1);
+    CHECK_EQUALS(realm.objects<Person>().where(older_than, 50).size(), 0);
+
+    auto named_and_older_than = realm::compile_query<Person>([](auto& person, auto& name, auto& age) {
+        return person.name == name && person.age > age;
+    });
+    CHECK_EQUALS(realm.objects<Person>().where(named_and_older_than, std::string("John"), 18).size(), 1);
+    CHECK_EQUALS(realm.objects<Person>().where(named_and_older_than, std::string("Jane"), 18).size(), 0);
+
+    co_return;
+}
+
+TEST(tsq_in_between) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink, Dog>({.path=path});
+
+    realm.write([&realm] {
+        for (int i = 0; i < 10; i++) {
+            realm.add(AllTypesObject { ._id = i, .enum_col = i % 2 ? AllTypesObject::Enum::one : AllTypesObject::Enum::two });
+        }
+    });
+
+    auto ids = std::vector<int>({1, 3, 5, 42});
+    validate_equals<AllTypesObject>(realm, 3U, [&ids](auto& o) { return o._id.in(ids); });
+    validate_equals<AllTypesObject>(realm, 0U, [](auto& o) { return o._id.in(std::vector<int>()); });
+    validate_equals<AllTypesObject>(realm, 2U, [&ids](auto& o) { return o._id.in(ids) && o._id > 1; });
+    auto enums = std::vector<AllTypesObject::Enum>({AllTypesObject::Enum::one});
+    validate_equals<AllTypesObject>(realm, 5U, [&enums](auto& o) { return o.enum_col.in(enums); });
+
+    validate_equals<AllTypesObject>(realm, 4U, [](auto& o) { return o._id.between(2, 5); });
+    validate_equals<AllTypesObject>(realm, 1U, [](auto& o) { return o._id.between(9, 100); });
+    validate_equals<AllTypesObject>(realm, 0U, [](auto& o) { return o._id.between(5, 2); });
+
+    auto obj = AllTypesObject { ._id = 3 };
+    CHECK(obj._id.in(ids));
+    CHECK(obj._id.between(0, 3));
+    co_return;
+}
+
+TEST(tsq_link) {
+    auto realm = realm::open<Person, Dog, AllTypesObject, AllTypesObjectLink>({.path=path});
+
+    realm.write([&realm] {
+        auto person = Person { .name = "John", .age = 42 };
+        person.dog = Dog { .name = "Fido", .age = 5 };
+        realm.add(person);
+        realm.add(Person { .name = "Jane", .age = 17 });
+
+        auto obj = AllTypesObject { ._id = 1 };
+        obj.list_obj_col.push_back(AllTypesObjectLink { ._id = 1, .str_col = "foo" });
+        obj.list_obj_col.push_back(AllTypesObjectLink { ._id = 2, .str_col = "bar" });
+        realm.add(obj);
+    });
+
+    validate_equals<Person>(realm, 1U, [](auto& person) { return person.dog->name == "Fido"; });
+    validate_equals<Person>(realm, 0U, [](auto& person) { return person.dog->name == "Rex"; });
+    validate_equals<Person>(realm, 1U, [](auto& person) { return person.dog->age < 10 && person.age > 18; });
+    validate_equals<Person>(realm, 0U, [](auto& person) { return person.dog->age.between(6, 10); });
+
+    validate_equals<AllTypesObject>(realm, 1U, [](auto& o) { return o.list_obj_col.any().str_col == "foo"; });
+    validate_equals<AllTypesObject>(realm, 0U, [](auto& o) { return o.list_obj_col.all().str_col == "foo"; });
+    validate_equals<AllTypesObject>(realm, 1U, [](auto& o) { return o.list_obj_col.none().str_col == "baz"; });
+    validate_equals<AllTypesObject>(realm, 1U, [](auto& o) { return o.list_obj_col.any()._id.in(std::vector<int>({2})); });
+    // Several comparisons through a list would each be quantified on their own.
+    CHECK_THROWS([&realm] { return realm.objects<AllTypesObject>().where([](auto& o) { return o.list_obj_col.all()._id.between(1, 2); }); });
+    CHECK_THROWS([&realm] { return realm.objects<AllTypesObject>().where([](auto& o) { return o.list_obj_col.all()._id.in(std::vector<int>({1, 3})); }); });
+    // Under any(), in() is a disjunction of quantified comparisons and can be used.
+    validate_equals<AllTypesObject>(realm, 1U, [](auto& o) { return o.list_obj_col.any()._id.in(std::vector<int>({1, 3})); });
+    validate_equals<AllTypesObject>(realm, 0U, [](auto& o) { return o.list_obj_col.any()._id.in(std::vector<int>({3, 4})); });
+
+    auto person = Person();
+    CHECK_THROWS([&person] { return *person.dog->name; });
+    auto jane = realm.objects<Person>().where([](auto& p) { return p.name == "Jane"; });
+    auto managed_person = *jane.begin();
+    CHECK_THROWS([&managed_person] { return *managed_person.dog->name; });
+    co_return;
+}
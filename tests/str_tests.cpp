@@ -45,4 +45,35 @@ TEST(managed_str_contains) {
     });
     CHECK(obj.str_col.contains("oo"));
     co_return;
-}
\ No newline at end of file
+}
+TEST(str_matches) {
+    auto obj = AllTypesObject();
+    obj.str_col = "The quick brown Fox";
+    CHECK(obj.str_col.matches("quick fox"));
+    CHECK(!obj.str_col.matches("quick dog"));
+
+    auto realm = get_realm(path);
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+        realm.add(AllTypesObject { ._id = 1, .str_col = "a lazy dog" });
+    });
+    CHECK(obj.str_col.matches("QUICK brown"));
+
+    auto results = realm.objects<AllTypesObject>().where([](auto& o) { return o.str_col.matches("brown fox"); });
+    CHECK_EQUALS(results.size(), 1);
+    results = realm.objects<AllTypesObject>().where([](auto& o) { return o.str_col.matches("  DOG  "); });
+    CHECK_EQUALS(results.size(), 1);
+    results = realm.objects<AllTypesObject>().where([](auto& o) { return o.str_col.matches("fox dog"); });
+    CHECK_EQUALS(results.size(), 0);
+
+    // Non-ASCII letters fold the same way on objects and in queries.
+    auto unmanaged = AllTypesObject { ._id = 2, .str_col = "blåbærsyltetøy" };
+    CHECK(unmanaged.str_col.matches("BLÅBÆR"));
+    realm.write([&realm, &unmanaged] {
+        realm.add(unmanaged);
+    });
+    CHECK(unmanaged.str_col.matches("BLÅBÆR"));
+    results = realm.objects<AllTypesObject>().where([](auto& o) { return o.str_col.matches("SYLTETØY"); });
+    CHECK_EQUALS(results.size(), 1);
+    co_return;
+}
@@ -50,6 +50,9 @@ struct AllTypesObject: realm::object {
 
     realm::persisted<std::vector<AllTypesObjectLink>> list_obj_col;
 
+    realm::persisted<std::set<std::string>> set_str_col;
+    realm::persisted<std::map<std::string, int>> map_int_col;
+
     using schema = realm::schema<
     "AllTypesObject",
     realm::property<"_id", &AllTypesObject::_id, true>,
@@ -63,7 +66,9 @@ struct AllTypesObject: realm::object {
     realm::property<"list_uuid_col", &AllTypesObject::list_uuid_col>,
     realm::property<"list_binary_col", &AllTypesObject::list_binary_col>,
     realm::property<"list_date_col", &AllTypesObject::list_date_col>,
-    realm::property<"list_obj_col", &AllTypesObject::list_obj_col>>;
+    realm::property<"list_obj_col", &AllTypesObject::list_obj_col>,
+    realm::property<"set_str_col", &AllTypesObject::set_str_col>,
+    realm::property<"map_int_col", &AllTypesObject::map_int_col>>;
 };
 
 
@@ -3,6 +3,8 @@
 
 #include <realm/object-store/impl/realm_coordinator.hpp>
 
+#include <future>
+
 
 TEST(all) {
     auto realm = realm::open<Person, Dog>({.path=path});
@@ -61,6 +63,107 @@ TEST(all) {
     co_return;
 }
 
+TEST(key_path_notifications) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    auto person = Person { .name = "John", .age = 17 };
+    realm.write([&realm, &person] {
+        realm.add(person);
+    });
+
+    std::vector<std::string> changed;
+    auto token = person.observe<Person>([&changed](auto&& change) {
+        changed.push_back(change.property.name);
+    }, &Person::name);
+
+    realm.write([&person] {
+        person.age = 18;
+    });
+    realm.write([] { });
+    CHECK_EQUALS(changed.size(), 0);
+
+    realm.write([&person] {
+        person.name = "Jim";
+    });
+    realm.write([] { });
+    CHECK_EQUALS(changed.size(), 1);
+    CHECK_EQUALS(changed[0], "name");
+    co_return;
+}
+
+TEST(coalesced_notifications) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    auto person = Person { .name = "John", .age = 17 };
+    realm.write([&realm, &person] {
+        realm.add(person);
+    });
+
+    int callback_count = 0;
+    std::vector<realm::PropertyChange> properties;
+    auto token = person.observe_coalesced<Person>([&](auto&& change) {
+        callback_count++;
+        properties = change.properties;
+    });
+
+    realm.write([&person] {
+        person.name = "Jim";
+        person.age = 18;
+    });
+    realm.write([] { });
+    CHECK_EQUALS(callback_count, 1);
+    CHECK_EQUALS(properties.size(), 2);
+    CHECK_EQUALS(properties[0].name, "name");
+    CHECK_EQUALS(std::any_cast<int>(*properties[1].new_value), 18);
+    co_return;
+}
+
+TEST(typed_notifications) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    auto person = Person { .name = "John", .age = 17 };
+    realm.write([&realm, &person] {
+        realm.add(person);
+    });
+
+    int callback_count = 0;
+    std::optional<int> old_age;
+    int new_age = 0;
+    auto token = person.observe_typed<Person>([&](auto& change) {
+        callback_count++;
+        CHECK_EQUALS(change.properties.size(), 1);
+        CHECK_EQUALS(std::string(change.properties[0].name), "age");
+        old_age.reset();
+        if (auto& old_value = change.properties[0].old_value) {
+            old_age = std::get<1>(*old_value);
+        }
+        new_age = std::get<1>(change.properties[0].new_value);
+    }, true);
+
+    // A commit on this thread is delivered after the object has changed, so it has no old values.
+    realm.write([&person] {
+        person.age = 18;
+    });
+    realm.write([] { });
+    CHECK_EQUALS(callback_count, 1);
+    CHECK(!old_age);
+    CHECK_EQUALS(new_age, 18);
+
+    auto tsr = realm::thread_safe_reference<Person>(person);
+    std::async(std::launch::async, [&tsr, &path] {
+        auto realm = realm::open<Person, Dog>({.path=path});
+        auto person = realm.resolve(std::move(tsr));
+        realm.write([&person] {
+            person.age = 19;
+        });
+    }).get();
+    realm.write([] { });
+    CHECK_EQUALS(callback_count, 2);
+    CHECK_EQUALS(*old_age, 18);
+    CHECK_EQUALS(new_age, 19);
+    co_return;
+}
+
 TEST(thread_safe_reference) {
     auto realm = realm::open<Person, Dog>({.path=path});
 
@@ -85,6 +188,94 @@ TEST(thread_safe_reference) {
     co_return;
 }
 
+TEST(executor_scheduler) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stop = false;
+    auto worker = std::thread([&] {
+        std::unique_lock lock(mutex);
+        while (true) {
+            cv.wait(lock, [&] { return stop || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    });
+    auto scheduler = std::make_shared<realm::util::ExecutorScheduler>([&](std::function<void()> task) {
+        std::lock_guard lock(mutex);
+        tasks.push_back(std::move(task));
+        cv.notify_all();
+    });
+
+    std::promise<std::string> delivered;
+    std::optional<realm::db<Person, Dog>> db;
+    std::optional<Person> person;
+    realm::notification_token token;
+    scheduler->invoke([&] {
+        CHECK(scheduler->is_on_thread());
+        db.emplace(realm::open<Person, Dog>({.path=path, .scheduler=scheduler}));
+        person = Person { .name = "John", .age = 17 };
+        db->write([&] { db->add(*person); });
+        token = person->observe<Person>([&delivered](auto&& change) {
+            delivered.set_value(change.property.name);
+        });
+        db->write([&] { person->age = 18; });
+    });
+    CHECK_EQUALS(delivered.get_future().get(), "age");
+
+    scheduler->invoke([&] {
+        token = {};
+        person.reset();
+        db.reset();
+    });
+    {
+        std::lock_guard lock(mutex);
+        stop = true;
+        cv.notify_all();
+    }
+    worker.join();
+    co_return;
+}
+
+#ifdef __linux__
+TEST(epoll_scheduler) {
+    auto scheduler = std::make_shared<realm::util::EpollScheduler>();
+    auto realm = realm::open<Person, Dog>({.path=path, .scheduler=scheduler});
+
+    auto person = Person { .name = "John", .age = 17 };
+    realm.write([&realm, &person] {
+        realm.add(person);
+    });
+    auto token = person.observe<Person>([&scheduler](auto&& change) {
+        CHECK_EQUALS(change.property.name, "age");
+        scheduler->stop();
+    });
+    auto thread = std::thread([&path] {
+        auto realm = realm::open<Person, Dog>({.path=path});
+        auto person = *realm.objects<Person>().begin();
+        realm.write([&person] { person.age = 18; });
+    });
+    thread.join();
+    scheduler->run();
+
+    bool did_run = false;
+    scheduler->invoke([&did_run] { did_run = true; });
+    CHECK(scheduler->run_once());
+    CHECK_EQUALS(did_run, true);
+
+    // A stop() issued before run() is not lost.
+    scheduler->stop();
+    scheduler->run();
+    co_return;
+}
+#endif
+
 TEST(query) {
     auto realm = realm::open<Person, Dog>({.path=path});
 
@@ -100,6 +291,201 @@ TEST(query) {
     co_return;
 }
 
+TEST(prepared_query) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    realm.write([&realm] {
+        realm.add(Person { .name = "John", .age = 42 });
+        realm.add(Person { .name = "Jane", .age = 17 });
+    });
+
+    auto by_age_and_name = realm.prepare<Person>("age > $0 AND name == $1");
+    CHECK_EQUALS(by_age_and_name.execute({18, "John"}).size(), 1);
+    CHECK_EQUALS(by_age_and_name.execute({18, "Jane"}).size(), 0);
+    CHECK_EQUALS(by_age_and_name.execute({10, "Jane"}).size(), 1);
+
+    CHECK_EQUALS(realm.objects<Person>().where("age > $0", {10}).size(), 2);
+    CHECK_EQUALS(realm.objects<Person>().where("age > $0", {20}).size(), 1);
+    CHECK_EQUALS(realm.query_cache_stats().misses, 1);
+    CHECK_EQUALS(realm.query_cache_stats().hits, 1);
+    co_return;
+}
+
+TEST(pagination) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
+
+    realm.write([&realm] {
+        for (int i = 0; i < 10; i++) {
+            realm.add(AllTypesObject{._id=i});
+        }
+    });
+
+    CHECK_EQUALS(realm.objects<AllTypesObject>().limit(3).size(), 3);
+    CHECK_EQUALS(realm.objects<AllTypesObject>().limit(20).size(), 10);
+
+    auto page = realm.objects<AllTypesObject>().after(3).limit(4);
+    CHECK_EQUALS(page.size(), 4);
+    int expected_id = 4;
+    for (auto& obj : page) {
+        CHECK_EQUALS(*obj._id, expected_id++);
+    }
+    CHECK_EQUALS(realm.objects<AllTypesObject>().after(8).limit(4).size(), 1);
+    CHECK_EQUALS(realm.objects<AllTypesObject>().after(9).size(), 0);
+    co_return;
+}
+
+TEST(results_notifications) {
+    auto realm = realm::open<Person, Dog>({.path=path});
+
+    auto adults = realm.objects<Person>().where([](auto& person) { return person.age >= 18; });
+    int callback_count = 0;
+    realm::ResultsChange<Person> change;
+    auto token = adults.observe([&](realm::ResultsChange<Person> c, std::exception_ptr) {
+        CHECK_EQUALS(c.collection, &adults);
+        callback_count++;
+        change = std::move(c);
+    });
+
+    auto person = Person { .name = "John", .age = 17 };
+    realm.write([&realm, &person] {
+        realm.add(person);
+        realm.add(Person { .name = "Jane", .age = 42 });
+    });
+    realm.write([] { });
+    CHECK_EQUALS(change.insertions.size(), 1);
+
+    realm.write([&person] {
+        person.age = 18;
+    });
+    realm.write([] { });
+    CHECK_EQUALS(change.insertions.size(), 1);
+    CHECK_EQUALS(adults.size(), 2);
+
+    realm.write([&realm, &person] {
+        realm.remove(person);
+    });
+    realm.write([] { });
+    CHECK_EQUALS(change.deletions.size(), 1);
+    CHECK_EQUALS(callback_count, 4);
+    co_return;
+}
+
+TEST(objects_by_primary_key) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
+
+    realm.write([&realm] {
+        for (int i = 0; i < 10; i++) {
+            realm.add(AllTypesObject{._id=i, .str_col=std::to_string(i)});
+        }
+    });
+
+    auto keys = std::vector<int>({7, 42, 0, 3});
+    auto objects = realm.objects_by_primary_key<AllTypesObject>(keys);
+    CHECK_EQUALS(objects.size(), 4);
+    CHECK_EQUALS(*objects[0]->str_col, "7");
+    CHECK_EQUALS(objects[1].has_value(), false);
+    CHECK_EQUALS(*objects[2]->str_col, "0");
+    CHECK_EQUALS(*objects[3]->str_col, "3");
+    CHECK_EQUALS(realm.objects_by_primary_key<AllTypesObject>(std::vector<int>()).size(), 0);
+    co_return;
+}
+
+namespace {
+struct Cat: realm::object {
+    realm::persisted<std::string> name;
+
+    using schema = realm::schema<"Cat", realm::property<"name", &Cat::name>>;
+};
+struct IndexedCat: realm::object {
+    realm::persisted<std::string> name;
+
+    using schema = realm::schema<"Cat", realm::indexed_property<"name", &IndexedCat::name>>;
+};
+}
+
+TEST(indexed_property) {
+    auto has_index = [&path] {
+        auto realm = realm::Realm::get_shared_realm({.path = path, .schema_mode = realm::SchemaMode::AdditiveExplicit});
+        auto table = realm->read_group().get_table("class_Cat");
+        return table->has_search_index(table->get_column_key("name"));
+    };
+
+    {
+        auto realm = realm::open<Cat>({.path=path});
+        realm.write([&realm] {
+            realm.add(Cat { .name = "Tom" });
+        });
+    }
+    CHECK_EQUALS(has_index(), false);
+    {
+        auto realm = realm::open<IndexedCat>({.path=path});
+        CHECK_EQUALS(realm.objects<IndexedCat>().where([](auto& cat) { return cat.name == "Tom"; }).size(), 1);
+    }
+    CHECK_EQUALS(has_index(), true);
+    {
+        auto realm = realm::open<Cat>({.path=path});
+        CHECK_EQUALS(realm.objects<Cat>().size(), 1);
+    }
+    CHECK_EQUALS(has_index(), false);
+    co_return;
+}
+
+namespace {
+struct Owner;
+struct Pet: realm::object {
+    realm::persisted<std::string> name;
+    realm::linking_objects<Owner, "pet"> owners;
+
+    using schema = realm::schema<"Pet",
+                                 realm::property<"name", &Pet::name>,
+                                 realm::property<"owners", &Pet::owners>>;
+};
+struct Owner: realm::object {
+    realm::persisted<std::string> name;
+    realm::persisted<std::optional<Pet>> pet;
+
+    using schema = realm::schema<"Owner",
+                                 realm::property<"name", &Owner::name>,
+                                 realm::property<"pet", &Owner::pet>>;
+};
+}
+
+TEST(linking_objects) {
+    auto realm = realm::open<Pet, Owner>({.path=path});
+
+    auto pet = Pet { .name = "Fido" };
+    CHECK_EQUALS(pet.owners.size(), 0);
+    realm.write([&realm, &pet] {
+        realm.add(pet);
+        for (auto name : {"John", "Jane"}) {
+            auto owner = Owner { .name = name };
+            realm.add(owner);
+            owner.pet = pet;
+        }
+        realm.add(Owner { .name = "Jim" });
+    });
+
+    CHECK_EQUALS(pet.owners.size(), 2);
+    CHECK_EQUALS((*pet.owners).size(), 2);
+    size_t count = 0;
+    for (auto& owner : pet.owners) {
+        CHECK_EQUALS(*(**owner.pet).name, "Fido");
+        // Objects reached through a link carry the Realm, so their linking objects can be read.
+        CHECK_EQUALS((**owner.pet).owners.size(), 2);
+        count++;
+    }
+    CHECK_EQUALS(count, 2);
+    CHECK_EQUALS(pet.owners.where("name == $0", {"Jane"}).size(), 1);
+    CHECK_EQUALS(pet.owners.where([](auto& owner) { return owner.name == "Jim"; }).size(), 0);
+
+    auto owner = realm.objects<Owner>().where("name == $0", {"John"});
+    realm.write([&realm, &owner] {
+        realm.remove(*owner.begin());
+    });
+    CHECK_EQUALS(pet.owners.size(), 1);
+    co_return;
+}
+
 TEST(binary) {
     auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
     auto obj = AllTypesObject();
@@ -119,6 +505,77 @@ TEST(binary) {
     co_return;
 }
 
+TEST(binary_append) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
+    auto obj = AllTypesObject();
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+
+    // Appends are collected and written once when the transaction ends.
+    realm.write([&obj] {
+        obj.binary_col.reserve(100000);
+        for (int i = 0; i < 100000; i++) {
+            obj.binary_col.push_back(static_cast<uint8_t>(i));
+        }
+        CHECK_EQUALS(obj.binary_col.size(), 100000);
+    });
+    CHECK_EQUALS(obj.binary_col.size(), 100000);
+    CHECK_EQUALS(obj.binary_col[255], 255);
+    CHECK_EQUALS(obj.binary_col[99999], static_cast<uint8_t>(99999));
+
+    // Reading through the property writes the appends made so far.
+    realm.write([&obj] {
+        obj.binary_col.push_back(1);
+        CHECK_EQUALS(obj.binary_col[100000], 1);
+        obj.binary_col.push_back(2);
+    });
+    CHECK_EQUALS(obj.binary_col.size(), 100002);
+    CHECK_EQUALS(obj.binary_col[100001], 2);
+    co_return;
+}
+
+TEST(binary_writer) {
+    auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
+    auto obj = AllTypesObject();
+    std::vector<uint8_t> bytes = {1, 2, 3};
+    obj.binary_col.append(bytes);
+    realm.write([&realm, &obj] {
+        realm.add(obj);
+    });
+    CHECK_EQUALS(obj.binary_col.size(), 3);
+
+    realm.write([&obj, &bytes] {
+        obj.binary_col.append(bytes);
+        auto writer = obj.binary_col.writer();
+        writer.reserve(6 + 1024 * 1024);
+        std::vector<uint8_t> chunk(1024, 7);
+        for (int i = 0; i < 1024; i++) {
+            writer.write(chunk);
+        }
+        writer.close();
+    });
+    CHECK_EQUALS(obj.binary_col.size(), 6 + 1024 * 1024);
+    CHECK_EQUALS(obj.binary_col[5], 3);
+    CHECK_EQUALS(obj.binary_col[6], 7);
+    CHECK_EQUALS(obj.binary_col[6 + 1024 * 1024 - 1], 7);
+
+    // A writer which is not closed, or holds more than core can store, leaves the data unchanged.
+    realm.write([&obj] {
+        auto writer = obj.binary_col.writer();
+        writer.write(std::vector<uint8_t>{9});
+    });
+    realm.write([&obj] {
+        CHECK_THROWS([&obj] {
+            auto writer = obj.binary_col.writer();
+            writer.write(std::vector<uint8_t>(realm::Table::max_binary_size + 1));
+            writer.close();
+        });
+    });
+    CHECK_EQUALS(obj.binary_col.size(), 6 + 1024 * 1024);
+    co_return;
+}
+
 TEST(date) {
     auto realm = realm::open<AllTypesObject, AllTypesObjectLink>({.path=path});
     auto obj = AllTypesObject();